@@ -0,0 +1,427 @@
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "hashmap.h"
+
+// Bounded cache with CLOCK eviction (second chance), sized in bytes:
+// Entries live inline in a ring of slots and a HashMap maps the hash of each key to its slot
+// (keys with the same hash are chained through their slots), so a key is stored only once.
+// A hit only sets the slot's referenced bit, so get is a hash lookup plus one store, with no
+// list to reorder like in a textbook LRU. When a put would go over the byte capacity, the
+// clock hand sweeps the ring: a referenced entry loses its bit and survives one more round,
+// an unreferenced one is evicted. Every entry is swept past at most twice per eviction round,
+// so get and put are O(1) amortized. Recently used entries survive, one-off entries go first,
+// close to LRU.
+//
+// The bytes counted are what the cache really holds: the slot ring and the index at their
+// current capacity (neither shrinks), plus the heap memory keys and values own, which
+// EntryBytes reports; specialize it for types that own heap memory.
+
+template <typename T>
+struct EntryBytes {
+    std::size_t operator()(const T&) const {
+        return 0;
+    }
+};
+
+template <>
+struct EntryBytes<std::string> {
+    std::size_t operator()(const std::string& s) const {
+        // short strings live inside the object
+        const char* data = s.data();
+        const char* self = reinterpret_cast<const char*>(&s);
+        bool inline_buffer = data >= self && data < self + sizeof(std::string);
+        return inline_buffer ? 0 : s.capacity() + 1;
+    }
+};
+
+struct CacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t insertions = 0;
+    uint64_t evictions = 0;
+    std::size_t entries = 0;
+    std::size_t bytes = 0;
+};
+
+template <typename K, typename V, typename F = KeyHash<K>>
+class ClockCache {
+private:
+    static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+    struct Slot {
+        K key;
+        V value;
+        uint64_t hash;
+        std::size_t heap_bytes;     // EntryBytes of key and value
+        uint32_t next;              // next slot with the same hash, or the next free slot
+        bool referenced;
+        bool used;
+    };
+
+    std::vector<Slot> slots;
+    uint32_t free_slots;            // head of the free list threaded through `next`
+    HashMap<uint64_t, uint32_t> index;
+    std::size_t hand;
+    std::size_t capacity_bytes;
+    std::size_t heap_bytes;
+    CacheStats counters;
+    F hashFunc;
+
+public:
+    explicit ClockCache(std::size_t capacity_bytes)
+        : free_slots(kNoSlot), hand(0), capacity_bytes(capacity_bytes), heap_bytes(0) {}
+
+    ClockCache(const ClockCache&) = delete;
+    ClockCache& operator=(const ClockCache&) = delete;
+
+    // pointer to the cached value, valid until the next put; nullptr on a miss
+    const V* find(const K& key) {
+        uint32_t slot = slotOf(key, hashFunc(key));
+        if (slot == kNoSlot) {
+            counters.misses++;
+            return nullptr;
+        }
+        counters.hits++;
+        slots[slot].referenced = true;
+        return &slots[slot].value;
+    }
+
+    bool get(const K& key, V& value) {
+        const V* found = find(key);
+        if (found == nullptr) {
+            return false;
+        }
+        value = *found;
+        return true;
+    }
+
+    // false when the entry does not fit even into an otherwise empty cache
+    bool put(const K& key, V value) {
+        std::size_t bytes = EntryBytes<K>{}(key) + EntryBytes<V>{}(value);
+        uint64_t hash = hashFunc(key);
+
+        uint32_t existing = slotOf(key, hash);
+        if (existing != kNoSlot) {
+            Slot& slot = slots[existing];
+            if (bytes + fixedBytes(1, false) > capacity_bytes) {
+                return false;
+            }
+            heap_bytes = heap_bytes - slot.heap_bytes + bytes;
+            slot.value = std::move(value);
+            slot.heap_bytes = bytes;
+            slot.referenced = true;
+            while (usedBytes() > capacity_bytes && evictOne(existing)) {
+            }
+            return true;
+        }
+
+        // an empty ring needs its first slots, any other frees one by evicting
+        if (bytes + fixedBytes(1, slots.empty()) > capacity_bytes) {
+            return false;
+        }
+        while (heap_bytes + bytes + fixedBytes(counters.entries + 1, needsGrowth()) > capacity_bytes
+               && evictOne(kNoSlot)) {
+        }
+
+        uint32_t slot_index;
+        if (free_slots != kNoSlot) {
+            slot_index = free_slots;
+            free_slots = slots[slot_index].next;
+        } else {
+            if (needsGrowth()) {
+                slots.reserve(grownCapacity());
+            }
+            slot_index = static_cast<uint32_t>(slots.size());
+            slots.emplace_back();
+        }
+        Slot& slot = slots[slot_index];
+        slot.key = key;
+        slot.value = std::move(value);
+        slot.hash = hash;
+        slot.heap_bytes = bytes;
+        // new entries start unreferenced: one that is never read again goes on the next sweep
+        slot.referenced = false;
+        slot.used = true;
+        slot.next = kNoSlot;
+        auto [head, inserted] = index.try_emplace(hash, slot_index);
+        if (!inserted) {
+            slot.next = *head;
+            *head = slot_index;
+        }
+
+        heap_bytes += bytes;
+        counters.insertions++;
+        counters.entries++;
+        return true;
+    }
+
+    bool erase(const K& key) {
+        uint32_t slot = slotOf(key, hashFunc(key));
+        if (slot == kNoSlot) {
+            return false;
+        }
+        release(slot);
+        return true;
+    }
+
+    CacheStats stats() const {
+        CacheStats current = counters;
+        current.bytes = usedBytes();
+        return current;
+    }
+
+    std::size_t capacity() const {
+        return capacity_bytes;
+    }
+
+private:
+    uint32_t slotOf(const K& key, uint64_t hash) const {
+        const uint32_t* head = index.find(hash);
+        uint32_t slot = head == nullptr ? kNoSlot : *head;
+        while (slot != kNoSlot && !(slots[slot].key == key)) {
+            slot = slots[slot].next;
+        }
+        return slot;
+    }
+
+    bool needsGrowth() const {
+        return free_slots == kNoSlot && slots.size() == slots.capacity();
+    }
+
+    // the ring grows by a quarter at a time, not by doubling, to stay close to its budget
+    std::size_t grownCapacity() const {
+        return slots.capacity() + slots.capacity() / 4 + 4;
+    }
+
+    // the slot ring and the index holding `entries` entries
+    std::size_t fixedBytes(std::size_t entries, bool grow_ring) const {
+        std::size_t ring = grow_ring ? grownCapacity() : slots.capacity();
+        return ring * sizeof(Slot) + index.memoryBytesFor(entries);
+    }
+
+    std::size_t usedBytes() const {
+        return heap_bytes + fixedBytes(counters.entries, false);
+    }
+
+    // evicts the next unreferenced entry the hand comes to, never the slot `keep`;
+    // false when there is nothing else left to evict
+    bool evictOne(uint32_t keep) {
+        if (counters.entries == 0 || (counters.entries == 1 && keep != kNoSlot)) {
+            return false;
+        }
+        while (true) {
+            if (hand >= slots.size()) {
+                hand = 0;
+            }
+            std::size_t current = hand++;
+            Slot& slot = slots[current];
+            if (!slot.used || current == keep) {
+                continue;
+            }
+            if (slot.referenced) {
+                slot.referenced = false;
+                continue;
+            }
+            release(static_cast<uint32_t>(current));
+            counters.evictions++;
+            return true;
+        }
+    }
+
+    void release(uint32_t slot_index) {
+        Slot& slot = slots[slot_index];
+        uint32_t* link = index.find(slot.hash);
+        if (*link == slot_index) {
+            if (slot.next == kNoSlot) {
+                index.remove(slot.hash);
+            } else {
+                *link = slot.next;
+            }
+        } else {
+            uint32_t prev = *link;
+            while (slots[prev].next != slot_index) {
+                prev = slots[prev].next;
+            }
+            slots[prev].next = slot.next;
+        }
+
+        heap_bytes -= slot.heap_bytes;
+        counters.entries--;
+        // drop what the entry owns, the slot itself stays in the ring
+        slot.key = K();
+        slot.value = V();
+        slot.used = false;
+        slot.referenced = false;
+        slot.next = free_slots;
+        free_slots = slot_index;
+    }
+};
+
+// ClockCache split into independently locked shards, each with an equal share of the bytes
+template <typename K, typename V, typename F = KeyHash<K>>
+class ShardedClockCache {
+private:
+    struct alignas(64) Shard {
+        std::mutex lock;
+        ClockCache<K, V, F> cache;
+
+        explicit Shard(std::size_t capacity_bytes): cache(capacity_bytes) {}
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::size_t shard_mask;
+    F hashFunc;
+
+public:
+    // shard_count is rounded up to a power of two
+    ShardedClockCache(std::size_t capacity_bytes, std::size_t shard_count = 16) {
+        std::size_t count = 1;
+        while (count < shard_count) {
+            count *= 2;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            shards.push_back(std::make_unique<Shard>(capacity_bytes / count));
+        }
+        shard_mask = count - 1;
+    }
+
+    // the value is copied out, a pointer into a shard would outlive its lock
+    bool get(const K& key, V& value) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> guard{shard.lock};
+        return shard.cache.get(key, value);
+    }
+
+    bool put(const K& key, V value) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> guard{shard.lock};
+        return shard.cache.put(key, std::move(value));
+    }
+
+    bool erase(const K& key) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> guard{shard.lock};
+        return shard.cache.erase(key);
+    }
+
+    // sum over the shards
+    CacheStats stats() {
+        CacheStats total;
+        for (auto& shard : shards) {
+            std::lock_guard<std::mutex> guard{shard->lock};
+            const CacheStats& s = shard->cache.stats();
+            total.hits += s.hits;
+            total.misses += s.misses;
+            total.insertions += s.insertions;
+            total.evictions += s.evictions;
+            total.entries += s.entries;
+            total.bytes += s.bytes;
+        }
+        return total;
+    }
+
+private:
+    Shard& shardFor(const K& key) {
+        return *shards[hashFunc(key) & shard_mask];
+    }
+};
+
+// keys drawn from a Zipf(1) distribution over key_space keys, like real cache traffic
+std::vector<int> zipfKeys(int count, int key_space, unsigned seed) {
+    std::vector<double> weights(key_space);
+    for (int i = 0; i < key_space; ++i) {
+        weights[i] = 1.0 / (i + 1);
+    }
+    std::discrete_distribution<int> zipf(weights.begin(), weights.end());
+    std::mt19937 rng{seed};
+    std::vector<int> keys(count);
+    for (auto& key : keys) {
+        key = zipf(rng);
+    }
+    return keys;
+}
+
+void printStats(const char* name, const CacheStats& stats, double seconds, long long ops) {
+    double hit_ratio = stats.hits + stats.misses == 0 ? 0.0 : 100.0 * stats.hits / (stats.hits + stats.misses);
+    std::cout << "  " << name << ": " << static_cast<long long>(ops / seconds) << " ops/s, hit ratio "
+              << static_cast<int>(hit_ratio) << "%, " << stats.evictions << " evictions, "
+              << stats.entries << " entries in " << stats.bytes << " bytes" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    // room for three of these pages, not four
+    ClockCache<std::string, std::string> pages{1600};
+    pages.put("/index", std::string(200, 'i'));
+    pages.put("/about", std::string(200, 'a'));
+    pages.find("/index");                          // /index gets its second chance
+    pages.put("/blog", std::string(300, 'b'));
+    pages.put("/shop", std::string(300, 's'));     // full: /about goes, /index was read
+
+    std::cout << "/index cached: " << (pages.find("/index") != nullptr)
+              << ", /about cached: " << (pages.find("/about") != nullptr) << std::endl;
+    std::cout << "hits " << pages.stats().hits << ", misses " << pages.stats().misses
+              << ", evictions " << pages.stats().evictions << ", bytes " << pages.stats().bytes << std::endl;
+
+    const int key_space = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const int ops = argc > 2 ? std::atoi(argv[2]) : 2000000;
+    const int max_threads = argc > 3 ? std::atoi(argv[3]) : 16;
+    const std::size_t capacity = argc > 4 ? std::atoll(argv[4]) : 16 << 20;
+    const int value_size = 100;
+
+    std::cout << "\nZipf keys over " << key_space << ", " << value_size << " byte values, "
+              << (capacity >> 10) << " KB cache" << std::endl;
+
+    // read-through: a miss loads the value and puts it into the cache
+    std::vector<int> keys = zipfKeys(ops, key_space, 42);
+    ClockCache<int, std::string> cache{capacity};
+    auto start = std::chrono::steady_clock::now();
+    std::string value;
+    for (int key : keys) {
+        if (!cache.get(key, value)) {
+            cache.put(key, std::string(value_size, 'x'));
+        }
+    }
+    printStats("ClockCache, 1 thread      ", cache.stats(),
+               std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), ops);
+
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        ShardedClockCache<int, std::string> shared{capacity, 16};
+        std::vector<std::vector<int>> thread_keys;
+        for (int t = 0; t < threads; ++t) {
+            thread_keys.push_back(zipfKeys(ops / threads, key_space, 42 + t));
+        }
+
+        start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&shared, &thread_keys, t, value_size] {
+                std::string local;
+                for (int key : thread_keys[t]) {
+                    if (!shared.get(key, local)) {
+                        shared.put(key, std::string(value_size, 'x'));
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::string name = "Sharded(16), " + std::to_string(threads) + " threads";
+        name.resize(26, ' ');
+        printStats(name.c_str(), shared.stats(), seconds, ops / threads * threads);
+    }
+
+    return 0;
+}
@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "hashmap.h"
+
+// Sharded HashMap for many threads (lock striping):
+// The keys are split over N independent HashMaps by the low bits of their hash, and every
+// shard has its own reader-writer lock. Threads working on different shards never touch
+// the same lock, and readers of one shard run in parallel; only put/remove take a shard
+// exclusively. Each shard sits on its own cache line and counts its reads, hits, writes and
+// how often a thread found its lock taken, so a hot shard shows up in shardStats().
+
+template <typename K, typename V, typename F = KeyHash<K>>
+class ConcurrentHashMap {
+private:
+    struct alignas(64) Shard {
+        mutable std::shared_mutex lock;
+        HashMap<K, V, F> map;
+        mutable std::atomic<uint64_t> reads{0};
+        mutable std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> writes{0};
+        mutable std::atomic<uint64_t> contended{0};
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::size_t shard_mask;
+    F hashFunc;
+
+public:
+    struct ShardStats {
+        std::size_t size;
+        uint64_t reads;
+        uint64_t hits;
+        uint64_t writes;
+        uint64_t contended;
+    };
+
+    // shard_count is rounded up to a power of two
+    explicit ConcurrentHashMap(std::size_t shard_count = 64) {
+        std::size_t count = 1;
+        while (count < shard_count) {
+            count *= 2;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            shards.push_back(std::make_unique<Shard>());
+        }
+        shard_mask = count - 1;
+    }
+
+    bool get(const K &key, V &value) const {
+        return getAs(key, value);
+    }
+
+    template <typename Q, typename G = F, typename = std::enable_if_t<IsTransparent<G>::value>>
+    bool get(const Q &key, V &value) const {
+        return getAs(key, value);
+    }
+
+    void put(const K &key, const V &value) {
+        Shard& shard = shardFor(key);
+        lockExclusive(shard);
+        shard.map.put(key, value);
+        shard.lock.unlock();
+        shard.writes.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // fn(V&) runs on the stored value under the shard's exclusive lock, no copy in or out
+    template <typename Fn>
+    bool update(const K &key, Fn&& fn) {
+        Shard& shard = shardFor(key);
+        lockExclusive(shard);
+        bool found = shard.map.update(key, std::forward<Fn>(fn));
+        shard.lock.unlock();
+        shard.writes.fetch_add(1, std::memory_order_relaxed);
+        return found;
+    }
+
+    void remove(const K &key) {
+        Shard& shard = shardFor(key);
+        lockExclusive(shard);
+        shard.map.remove(key);
+        shard.lock.unlock();
+        shard.writes.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // sum over the shards, each one read under its lock (not an atomic snapshot)
+    std::size_t size() const {
+        std::size_t total = 0;
+        for (auto& shard : shards) {
+            std::shared_lock<std::shared_mutex> guard{shard->lock};
+            total += shard->map.size();
+        }
+        return total;
+    }
+
+    std::size_t shardCount() const {
+        return shards.size();
+    }
+
+    ShardStats shardStats(std::size_t index) const {
+        const Shard& shard = *shards[index];
+        std::size_t size;
+        {
+            std::shared_lock<std::shared_mutex> guard{shard.lock};
+            size = shard.map.size();
+        }
+        return {size, shard.reads.load(), shard.hits.load(), shard.writes.load(), shard.contended.load()};
+    }
+
+private:
+    // HashMap picks the slot from the top bits of the hash, the shard uses the bottom ones
+    template <typename Q>
+    Shard& shardFor(const Q& key) const {
+        return *shards[hashFunc(key) & shard_mask];
+    }
+
+    template <typename Q>
+    bool getAs(const Q &key, V &value) const {
+        Shard& shard = shardFor(key);
+        if (!shard.lock.try_lock_shared()) {
+            shard.contended.fetch_add(1, std::memory_order_relaxed);
+            shard.lock.lock_shared();
+        }
+        bool found = shard.map.get(key, value);
+        shard.lock.unlock_shared();
+
+        shard.reads.fetch_add(1, std::memory_order_relaxed);
+        if (found) {
+            shard.hits.fetch_add(1, std::memory_order_relaxed);
+        }
+        return found;
+    }
+
+    void lockExclusive(Shard& shard) {
+        if (!shard.lock.try_lock()) {
+            shard.contended.fetch_add(1, std::memory_order_relaxed);
+            shard.lock.lock();
+        }
+    }
+};
+
+// session-cache workload: every thread does `ops` operations on random keys, 1 in 10 a put
+template <typename Map>
+double benchmark(Map& map, int threads, int ops, int key_space) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&map, t, ops, key_space] {
+            std::minstd_rand rng(t + 1);
+            long long value = 0;
+            for (int i = 0; i < ops; ++i) {
+                long long key = rng() % key_space;
+                if (rng() % 10 == 0) {
+                    map.put(key, i);
+                } else {
+                    map.get(key, value);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(threads) * ops / seconds;
+}
+
+int main(int argc, char* argv[]) {
+    ConcurrentHashMap<std::string, std::string> sessions{8};
+    sessions.put("3f9a", "alice");
+    sessions.put("77c1", "bob");
+
+    std::string user;
+    std::thread reader([&sessions] {
+        std::string name;
+        std::cout << "reader thread sees 77c1: " << sessions.get(std::string_view("77c1"), name) << std::endl;
+    });
+    reader.join();
+    sessions.remove("3f9a");
+    sessions.update("77c1", [](std::string& name) { name += " (2fa)"; });
+    sessions.get("77c1", user);
+    std::cout << "77c1 is now " << user << std::endl;
+    std::cout << "3f9a after logout: " << sessions.get("3f9a", user) << ", sessions: " << sessions.size() << std::endl;
+
+    // scaling from 1 to max_threads threads, one shard (a single reader-writer lock) against many
+    const int max_threads = argc > 1 ? std::atoi(argv[1]) : 64;
+    const int ops = argc > 2 ? std::atoi(argv[2]) : 200000;
+    const int key_space = argc > 3 ? std::atoi(argv[3]) : 100000;
+
+    std::cout << "\n" << ops << " ops per thread, 90% get / 10% put, " << key_space << " keys" << std::endl;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        ConcurrentHashMap<long long, long long> single{1};
+        ConcurrentHashMap<long long, long long> sharded{64};
+        for (long long key = 0; key < key_space; key += 2) {
+            single.put(key, key);
+            sharded.put(key, key);
+        }
+
+        double single_ops = benchmark(single, threads, ops, key_space);
+        double sharded_ops = benchmark(sharded, threads, ops, key_space);
+
+        uint64_t single_contended = single.shardStats(0).contended;
+        uint64_t sharded_contended = 0;
+        uint64_t busiest = 0;
+        for (std::size_t i = 0; i < sharded.shardCount(); ++i) {
+            auto stats = sharded.shardStats(i);
+            sharded_contended += stats.contended;
+            busiest = std::max(busiest, stats.reads + stats.writes);
+        }
+
+        std::cout << "  " << threads << " threads: 1 shard " << static_cast<long long>(single_ops) << " ops/s ("
+                  << single_contended << " contended), 64 shards " << static_cast<long long>(sharded_ops)
+                  << " ops/s (" << sharded_contended << " contended, busiest shard " << busiest << " ops)"
+                  << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,582 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Open addressing with Robin Hood hashing:
+// All key-value pairs live inline in one slot array, no node allocation per entry.
+// A key is placed at its home slot or, if taken, at one of the following
+// slots. dist[i] remembers how far slot i is from its key's home (+1, 0 means empty).
+// On insert, a key that is further from home takes the slot of a key that is closer to home
+// ("rob the rich"), which keeps probe sequences short and lets a lookup stop as soon as it
+// meets a slot closer to home than itself. The insert finds that slot first and moves the
+// entries behind it one slot on, then constructs the new entry right there, so it is never
+// moved around while its place is found.
+// On remove, the following entries are shifted one slot back (backward shift deletion),
+// so there are no tombstones slowing down later lookups.
+// The table doubles whenever it would be more than 7/8 full. A probe longer than
+// kMaxDistance also doubles it, but only when it is more than half full: keys that share one
+// hash value stay together at any size, so for them growing would never end and the probe
+// just goes on (dist[] is 32 bits wide, any distance fits).
+//
+// Lookups do not walk dist[] slot by slot: ctrl[] holds one control byte per slot, either
+// kEmpty or 7 bits of the key's hash. get() loads the 16 control bytes starting at the home
+// slot and compares them against the key's 7 bits all at once (SSE2, or a plain loop when
+// SSE2 is not available). Only the few slots whose bits match get a real key comparison,
+// and since a key is never stored past an empty slot, the first empty byte in the group ends
+// the search. ctrl[] repeats its first 15 bytes at the end so a group can run past the last slot.
+//
+// Hashing: KeyHash mixes integers and byte strings wyhash-style (multiply to 128 bits, fold
+// the halves), so sequential IDs spread over the whole table. The capacity is a power of two
+// and the home slot is the top bits of hash * 2^64/phi (fibonacci hashing): one multiply and
+// one shift instead of a division. The low 7 bits of the same product are the control byte.
+// The mixing spreads the values a hash function returns, it cannot add new ones: a custom hash
+// with only a few distinct results (like k % 10) still sends its keys to that many home slots.
+// KeyHash<std::string> is transparent, so get/remove also accept std::string_view or
+// const char* without building a temporary std::string.
+//
+// Values are never copied on the way in or out unless asked to: find() returns a pointer into
+// the slot, try_emplace/insert_or_assign construct or move the value into place, and
+// update() runs a callback on the stored value. A pointer from find() stays valid until the
+// next insert or remove, either of which may move entries around.
+//
+// The slot, dist and ctrl arrays come from a std::pmr::memory_resource, the default resource
+// unless one is passed to the constructor.
+
+template <typename K, typename V>
+class HashNode {
+private:
+
+    // key-value pair
+    K key;
+    V value;
+
+public:
+    HashNode(const K& key, const V& value): key(key), value(value) { }
+
+    // key and value constructed straight from the caller's arguments
+    template <typename KeyArg, typename... Args>
+    HashNode(std::piecewise_construct_t, KeyArg&& key, Args&&... args)
+        : key(std::forward<KeyArg>(key)), value(std::forward<Args>(args)...) { }
+
+    const K& getKey() const {
+        return key;
+    }
+
+    const V& getValue() const {
+        return value;
+    }
+
+    V& getValue() {
+        return value;
+    }
+
+    void setValue(const V& value) {
+        HashNode::value = value;
+    }
+
+    void setValue(V&& value) {
+        HashNode::value = std::move(value);
+    }
+};
+
+// 64 x 64 -> 128 bit multiply, high and low halves folded together
+inline uint64_t hashMix(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t product = static_cast<__uint128_t>(a) * b;
+    return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+    // no 128-bit type: multiply-xorshift finalizer (splitmix64)
+    uint64_t x = (a ^ (b >> 31)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31) ^ b;
+#endif
+}
+
+constexpr uint64_t kHashSecret0 = 0xa0761d6478bd642full;
+constexpr uint64_t kHashSecret1 = 0xe7037ed1a0b428dbull;
+
+inline uint64_t readBytes(const char* p, std::size_t n) {
+    uint64_t value = 0;
+    std::memcpy(&value, p, n);
+    return value;
+}
+
+// wyhash-style: 16 bytes per round, the tail zero-padded into the last round
+inline uint64_t hashBytes(const char* data, std::size_t length) {
+    uint64_t seed = kHashSecret0 ^ length;
+    std::size_t remaining = length;
+    while (remaining > 16) {
+        seed = hashMix(readBytes(data, 8) ^ kHashSecret1, readBytes(data + 8, 8) ^ seed);
+        data += 16;
+        remaining -= 16;
+    }
+
+    uint64_t a = readBytes(data, remaining < 8 ? remaining : 8);
+    uint64_t b = remaining > 8 ? readBytes(data + 8, remaining - 8) : 0;
+    return hashMix(kHashSecret1 ^ length, hashMix(a ^ kHashSecret1, b ^ seed));
+}
+
+template <typename K>
+struct KeyHash {
+    uint64_t operator()(const K& key) const
+    {
+        if constexpr (std::is_integral_v<K> || std::is_enum_v<K>) {
+            return hashMix(static_cast<uint64_t>(key) ^ kHashSecret0, kHashSecret1);
+        } else {
+            // anything else: std::hash, mixed so weak identity hashes are spread out too
+            return hashMix(static_cast<uint64_t>(std::hash<K>{}(key)) ^ kHashSecret0, kHashSecret1);
+        }
+    }
+};
+
+template <>
+struct KeyHash<std::string> {
+    using is_transparent = void;
+
+    uint64_t operator()(std::string_view key) const
+    {
+        return hashBytes(key.data(), key.size());
+    }
+};
+
+// 16 control bytes compared in one go, bit i of a mask stands for byte i of the group
+struct ControlGroup {
+    static constexpr int kWidth = 16;
+    static constexpr uint8_t kEmpty = 0x80;
+
+#if defined(__SSE2__)
+    __m128i bytes;
+
+    explicit ControlGroup(const uint8_t* ctrl)
+        : bytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+    uint32_t match(uint8_t fragment) const {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(static_cast<char>(fragment)))));
+    }
+
+    // fragments never have the high bit set, so the sign bits are exactly the empty slots
+    uint32_t empties() const {
+        return static_cast<uint32_t>(_mm_movemask_epi8(bytes));
+    }
+#else
+    const uint8_t* bytes;
+
+    explicit ControlGroup(const uint8_t* ctrl): bytes(ctrl) {}
+
+    uint32_t match(uint8_t fragment) const {
+        uint32_t mask = 0;
+        for (int i = 0; i < kWidth; ++i) {
+            mask |= static_cast<uint32_t>(bytes[i] == fragment) << i;
+        }
+        return mask;
+    }
+
+    uint32_t empties() const {
+        return match(kEmpty);
+    }
+#endif
+};
+
+template <typename F, typename = void>
+struct IsTransparent : std::false_type {};
+
+template <typename F>
+struct IsTransparent<F, std::void_t<typename F::is_transparent>> : std::true_type {};
+
+template <typename K, typename V, typename F = KeyHash<K>>
+class HashMap {
+private:
+    static constexpr std::size_t kInitialCapacity = 16;
+    static constexpr unsigned int kMaxDistance = 255;
+
+    HashNode<K, V>* table;     // raw slot storage, a slot is constructed only when dist > 0
+    uint32_t* dist;
+    uint8_t* ctrl;             // capacity + 15 control bytes
+    std::size_t capacity;      // always a power of two
+    int shift;                 // 64 - log2(capacity)
+    std::size_t count;
+    F hashFunc;
+    std::pmr::memory_resource* resource;
+
+public:
+    explicit HashMap(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : table(nullptr), dist(nullptr), ctrl(nullptr), capacity(0), shift(64), count(0), resource(resource) {
+        allocate(kInitialCapacity);
+    }
+
+    ~HashMap() {
+        release();
+    }
+
+    HashMap(const HashMap&) = delete;
+    HashMap& operator=(const HashMap&) = delete;
+
+    std::size_t size() const {
+        return count;
+    }
+
+    // bytes of the slot, dist and ctrl arrays
+    std::size_t memoryBytes() const {
+        return arrayBytes(capacity);
+    }
+
+    // the same once the map holds `entries` keys, counting the doubling that takes
+    std::size_t memoryBytesFor(std::size_t entries) const {
+        std::size_t grown = capacity;
+        while (entries * 8 > grown * 7) {
+            grown *= 2;
+        }
+        return arrayBytes(grown);
+    }
+
+    // pointer to the stored value, nullptr when the key is missing
+    V* find(const K &key) {
+        return findAs(key);
+    }
+
+    const V* find(const K &key) const {
+        return const_cast<HashMap*>(this)->findAs(key);
+    }
+
+    // heterogeneous lookup, e.g. a std::string_view into a map with std::string keys
+    template <typename Q, typename G = F, typename = std::enable_if_t<IsTransparent<G>::value>>
+    V* find(const Q &key) {
+        return findAs(key);
+    }
+
+    template <typename Q, typename G = F, typename = std::enable_if_t<IsTransparent<G>::value>>
+    const V* find(const Q &key) const {
+        return const_cast<HashMap*>(this)->findAs(key);
+    }
+
+    // copies the value out
+    bool get(const K &key, V &value) const {
+        return getAs(key, value);
+    }
+
+    template <typename Q, typename G = F, typename = std::enable_if_t<IsTransparent<G>::value>>
+    bool get(const Q &key, V &value) const {
+        return getAs(key, value);
+    }
+
+    // calls fn(V&) on the stored value in place; false when the key is missing
+    template <typename Fn>
+    bool update(const K &key, Fn&& fn) {
+        V* value = findAs(key);
+        if (value == nullptr) {
+            return false;
+        }
+        fn(*value);
+        return true;
+    }
+
+    template <typename Q, typename Fn, typename G = F, typename = std::enable_if_t<IsTransparent<G>::value>>
+    bool update(const Q &key, Fn&& fn) {
+        V* value = findAs(key);
+        if (value == nullptr) {
+            return false;
+        }
+        fn(*value);
+        return true;
+    }
+
+    void remove(const K &key) {
+        removeAs(key);
+    }
+
+    template <typename Q, typename G = F, typename = std::enable_if_t<IsTransparent<G>::value>>
+    void remove(const Q &key) {
+        removeAs(key);
+    }
+
+    void put(const K &key, const V &value) {
+        insert_or_assign(key, value);
+    }
+
+    // constructs V from args only when the key is new; the bool tells whether it was inserted
+    template <typename... Args>
+    std::pair<V*, bool> try_emplace(const K &key, Args&&... args) {
+        return tryEmplaceAs(key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    std::pair<V*, bool> try_emplace(K &&key, Args&&... args) {
+        return tryEmplaceAs(std::move(key), std::forward<Args>(args)...);
+    }
+
+    // inserts, or assigns over the existing value; the bool tells whether it was inserted
+    template <typename M>
+    std::pair<V*, bool> insert_or_assign(const K &key, M&& value) {
+        return insertOrAssignAs(key, std::forward<M>(value));
+    }
+
+    template <typename M>
+    std::pair<V*, bool> insert_or_assign(K &&key, M&& value) {
+        return insertOrAssignAs(std::move(key), std::forward<M>(value));
+    }
+
+private:
+    template <typename Q>
+    V* findAs(const Q &key) {
+        std::size_t index = findSlot(key);
+        return index == capacity ? nullptr : &table[index].getValue();
+    }
+
+    template <typename KeyArg, typename... Args>
+    std::pair<V*, bool> tryEmplaceAs(KeyArg&& key, Args&&... args) {
+        std::size_t index = findSlot(key);
+        if (index != capacity) {
+            return {&table[index].getValue(), false};
+        }
+
+        if ((count + 1) * 8 > capacity * 7) {
+            rehash(capacity * 2);
+        }
+        uint64_t scrambled = scramble(hashFunc(key));
+        index = openSlot(scrambled);
+        constructAt(index, scrambled, std::forward<KeyArg>(key), std::forward<Args>(args)...);
+        return {&table[index].getValue(), true};
+    }
+
+    template <typename KeyArg, typename M>
+    std::pair<V*, bool> insertOrAssignAs(KeyArg&& key, M&& value) {
+        std::size_t index = findSlot(key);
+        if (index != capacity) {
+            // just update the value
+            table[index].getValue() = std::forward<M>(value);
+            return {&table[index].getValue(), false};
+        }
+
+        if ((count + 1) * 8 > capacity * 7) {
+            rehash(capacity * 2);
+        }
+        uint64_t scrambled = scramble(hashFunc(key));
+        index = openSlot(scrambled);
+        constructAt(index, scrambled, std::forward<KeyArg>(key), std::forward<M>(value));
+        return {&table[index].getValue(), true};
+    }
+
+    template <typename Q>
+    bool getAs(const Q &key, V &value) const {
+        std::size_t index = findSlot(key);
+        if (index == capacity) {
+            return false;
+        }
+        value = table[index].getValue();
+        return true;
+    }
+
+    template <typename Q>
+    void removeAs(const Q &key) {
+        std::size_t index = findSlot(key);
+        if (index == capacity) {
+            // key not found
+            return;
+        }
+
+        table[index].~HashNode<K, V>();
+        count--;
+
+        // pull every following entry that is not at its home one slot back
+        closeSlot(index);
+    }
+
+    // fibonacci hashing: the top bits of the product pick the home slot,
+    // the low 7 bits become the control byte
+    uint64_t scramble(uint64_t hash) const {
+        return hash * 0x9E3779B97F4A7C15ull;
+    }
+
+    std::size_t home(uint64_t scrambled) const {
+        return shift == 64 ? 0 : static_cast<std::size_t>(scrambled >> shift);
+    }
+
+    static uint8_t fragment(uint64_t scrambled) {
+        return static_cast<uint8_t>(scrambled & 0x7F);
+    }
+
+    void setCtrl(std::size_t index, uint8_t value) {
+        ctrl[index] = value;
+        if (index < ControlGroup::kWidth - 1) {
+            ctrl[capacity + index] = value;
+        }
+    }
+
+    std::size_t nextSlot(std::size_t index) const {
+        return (index + 1) & (capacity - 1);
+    }
+
+    // slot index of key, or capacity when it is not in the table
+    template <typename Q>
+    std::size_t findSlot(const Q& key) const {
+        uint64_t scrambled = scramble(hashFunc(key));
+        std::size_t group_start = home(scrambled);
+        const uint8_t wanted = fragment(scrambled);
+
+        while (true) {
+            ControlGroup group{ctrl + group_start};
+            uint32_t candidates = group.match(wanted);
+            uint32_t empties = group.empties();
+
+            // key can only be before the first empty slot
+            if (empties != 0) {
+                candidates &= (empties & (0u - empties)) - 1;
+            }
+
+            while (candidates != 0) {
+                std::size_t index = group_start + __builtin_ctz(candidates);
+                index &= capacity - 1;
+                if (table[index].getKey() == key) {
+                    return index;
+                }
+                candidates &= candidates - 1;
+            }
+
+            if (empties != 0) {
+                return capacity;
+            }
+            group_start = (group_start + ControlGroup::kWidth) & (capacity - 1);
+        }
+    }
+
+    // Frees the slot a new key with this hash belongs in and returns it: the first slot that is
+    // empty or holds a key closer to its home than the new key would be. The run from there up
+    // to the next empty slot moves one slot on, which is where the Robin Hood swaps would have
+    // put those keys, so the new entry can then be constructed directly in its final slot.
+    std::size_t openSlot(uint64_t scrambled) {
+        while (true) {
+            std::size_t index = home(scrambled);
+            unsigned int distance = 1;
+            while (dist[index] != 0 && dist[index] >= distance) {
+                index = nextSlot(index);
+                distance++;
+            }
+
+            std::size_t empty = index;
+            unsigned int longest = distance;
+            while (dist[empty] != 0) {
+                longest = std::max(longest, dist[empty] + 1);
+                empty = nextSlot(empty);
+            }
+            if (longest >= kMaxDistance && count * 2 > capacity) {
+                // clustering in a fairly full table, grow and look again
+                rehash(capacity * 2);
+                continue;
+            }
+
+            while (empty != index) {
+                std::size_t prev = (empty - 1) & (capacity - 1);
+                new (&table[empty]) HashNode<K, V>(std::move(table[prev]));
+                table[prev].~HashNode<K, V>();
+                dist[empty] = dist[prev] + 1;
+                setCtrl(empty, ctrl[prev]);
+                empty = prev;
+            }
+            dist[index] = 0;
+            setCtrl(index, ControlGroup::kEmpty);
+            return index;
+        }
+    }
+
+    // builds the entry in a slot from openSlot(); if the constructor throws, the entries
+    // openSlot() moved on slide back and the table is as it was
+    template <typename... Args>
+    void constructAt(std::size_t index, uint64_t scrambled, Args&&... args) {
+        try {
+            new (&table[index]) HashNode<K, V>(std::piecewise_construct, std::forward<Args>(args)...);
+        } catch (...) {
+            closeSlot(index);
+            throw;
+        }
+        occupy(index, scrambled);
+    }
+
+    // records the entry just constructed in slot `index`
+    void occupy(std::size_t index, uint64_t scrambled) {
+        dist[index] = static_cast<uint32_t>(((index - home(scrambled)) & (capacity - 1)) + 1);
+        setCtrl(index, fragment(scrambled));
+        count++;
+    }
+
+    // backward shift deletion into the empty slot `index`
+    void closeSlot(std::size_t index) {
+        std::size_t next = nextSlot(index);
+        while (dist[next] > 1) {
+            new (&table[index]) HashNode<K, V>(std::move(table[next]));
+            table[next].~HashNode<K, V>();
+            dist[index] = dist[next] - 1;
+            setCtrl(index, ctrl[next]);
+            index = next;
+            next = nextSlot(next);
+        }
+        dist[index] = 0;
+        setCtrl(index, ControlGroup::kEmpty);
+    }
+
+    void allocate(std::size_t new_capacity) {
+        table = static_cast<HashNode<K, V>*>(resource->allocate(new_capacity * sizeof(HashNode<K, V>),
+                                                                alignof(HashNode<K, V>)));
+        dist = static_cast<uint32_t*>(resource->allocate(new_capacity * sizeof(uint32_t), alignof(uint32_t)));
+        std::fill(dist, dist + new_capacity, 0);
+        ctrl = static_cast<uint8_t*>(resource->allocate(new_capacity + ControlGroup::kWidth - 1, 1));
+        std::fill(ctrl, ctrl + new_capacity + ControlGroup::kWidth - 1, ControlGroup::kEmpty);
+        capacity = new_capacity;
+        shift = 64;
+        for (std::size_t c = new_capacity; c > 1; c >>= 1) {
+            shift--;
+        }
+        count = 0;
+    }
+
+    void release() {
+        for (std::size_t i = 0; i < capacity; ++i) {
+            if (dist[i] != 0) {
+                table[i].~HashNode<K, V>();
+            }
+        }
+        freeArrays(table, dist, ctrl, capacity);
+    }
+
+    static std::size_t arrayBytes(std::size_t slots) {
+        return slots * (sizeof(HashNode<K, V>) + sizeof(uint32_t) + 1) + ControlGroup::kWidth - 1;
+    }
+
+    void freeArrays(HashNode<K, V>* old_table, uint32_t* old_dist, uint8_t* old_ctrl, std::size_t old_capacity) {
+        resource->deallocate(old_table, old_capacity * sizeof(HashNode<K, V>), alignof(HashNode<K, V>));
+        resource->deallocate(old_dist, old_capacity * sizeof(uint32_t), alignof(uint32_t));
+        resource->deallocate(old_ctrl, old_capacity + ControlGroup::kWidth - 1, 1);
+    }
+
+    void rehash(std::size_t new_capacity) {
+        HashNode<K, V>* old_table = table;
+        uint32_t* old_dist = dist;
+        uint8_t* old_ctrl = ctrl;
+        std::size_t old_capacity = capacity;
+
+        allocate(new_capacity);
+        for (std::size_t i = 0; i < old_capacity; ++i) {
+            if (old_dist[i] != 0) {
+                HashNode<K, V>& node = old_table[i];
+                uint64_t scrambled = scramble(hashFunc(node.getKey()));
+                std::size_t index = openSlot(scrambled);
+                new (&table[index]) HashNode<K, V>(std::move(node));
+                occupy(index, scrambled);
+                node.~HashNode<K, V>();
+            }
+        }
+        freeArrays(old_table, old_dist, old_ctrl, old_capacity);
+    }
+};
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <math.h>
+#include <memory_resource>
 
 class Node {
 private:
@@ -11,8 +12,18 @@ public:
     Node(): data(0), next(NULL), prev(NULL) {}
     ~Node() {}
 
-    void insertAtBeginning(int data, Node** head, Node** tail, unsigned int& length) {
-        Node* newNode = new Node();
+    // nodes live in the list's memory resource instead of coming from new/delete
+    static Node* create(std::pmr::memory_resource* resource) {
+        return new (resource->allocate(sizeof(Node), alignof(Node))) Node();
+    }
+
+    static void destroy(Node* node, std::pmr::memory_resource* resource) {
+        node->~Node();
+        resource->deallocate(node, sizeof(Node), alignof(Node));
+    }
+
+    void insertAtBeginning(int data, Node** head, Node** tail, unsigned int& length, std::pmr::memory_resource* resource) {
+        Node* newNode = create(resource);
         newNode->data = data;
         newNode->prev = NULL;
         newNode->next = (*head);
@@ -27,8 +38,8 @@ public:
         length += 1;
     }
 
-    void insertAtEnd(int data, Node** head, Node** tail, unsigned int& length) {
-        Node* newNode = new Node();
+    void insertAtEnd(int data, Node** head, Node** tail, unsigned int& length, std::pmr::memory_resource* resource) {
+        Node* newNode = create(resource);
         newNode->data = data;
         newNode->prev = (*tail);
         newNode->next = NULL;
@@ -43,7 +54,7 @@ public:
         length += 1;
     }
 
-    void insertAt(unsigned int pos, int data, Node** head, Node** tail, unsigned int& length) {
+    void insertAt(unsigned int pos, int data, Node** head, Node** tail, unsigned int& length, std::pmr::memory_resource* resource) {
         if (length < 2) {
             std::cout << "At least, the Linkedlist length is greater than or equal to 2!" << std::endl;
         } else {
@@ -57,7 +68,7 @@ public:
                     ++iter;
                 }
 
-                Node* newNode = new Node();
+                Node* newNode = create(resource);
                 newNode->data = data;
                 newNode->next = current->next;
                 newNode->prev = current;
@@ -76,7 +87,7 @@ public:
                     iter--;
                 }
 
-                Node* newNode = new Node();
+                Node* newNode = create(resource);
                 newNode->data = data;
                 newNode->next = current->next;
                 newNode->prev = current;
@@ -91,7 +102,7 @@ public:
         length += 1;
     }
 
-    void deleteAtBeginning(Node** head, Node** tail, unsigned int& length) {
+    void deleteAtBeginning(Node** head, Node** tail, unsigned int& length, std::pmr::memory_resource* resource) {
         if (length > 0) {
             Node* current_head = (*head);
 
@@ -101,11 +112,11 @@ public:
                 (*head) = current_head->next;
 
                 length = length - 1;
-                delete current_head;
+                destroy(current_head, resource);
 
             } else {
                 length = length - 1;
-                delete current_head;
+                destroy(current_head, resource);
 
                 (*head) = NULL;
                 (*tail) = NULL;
@@ -115,7 +126,7 @@ public:
         }
     }
 
-    void deleteAtEnd(Node** head, Node** tail, unsigned int& length) {
+    void deleteAtEnd(Node** head, Node** tail, unsigned int& length, std::pmr::memory_resource* resource) {
         if (length > 0) {
             Node* current_tail = (*tail);
 
@@ -125,12 +136,12 @@ public:
                 (*tail) = current_tail->prev;
 
                 length = length - 1;
-                delete current_tail;
+                destroy(current_tail, resource);
 
             } else {
 
                 length = length - 1;
-                delete current_tail;
+                destroy(current_tail, resource);
 
                 (*head) = NULL;
                 (*tail) = NULL;
@@ -140,15 +151,15 @@ public:
         }
     }
 
-    void deleteAllNodes(Node** head, Node** tail, unsigned int& length) {
+    void deleteAllNodes(Node** head, Node** tail, unsigned int& length, std::pmr::memory_resource* resource) {
         if (length > 0) {
             Node* current = (*head);
             while (current->next != NULL) {
                 Node* temp = current;
                 current = current->next;
-                delete temp;
+                destroy(temp, resource);
             }
-            delete current;
+            destroy(current, resource);
 
             (*head) = NULL;
             (*tail) = NULL;
@@ -183,37 +194,42 @@ public:
     Node* head;
     Node* tail;
     Node* nodes;
+    std::pmr::memory_resource* resource;
 
-    LinkedList(): elementLength{0}, head{nullptr}, tail{nullptr} {
-        nodes = new Node();
+    explicit LinkedList(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : elementLength{0}, head{nullptr}, tail{nullptr}, resource{resource} {
+        nodes = Node::create(resource);
     }
 
     ~LinkedList() {
-        delete nodes;
+        if (elementLength > 0) {
+            deleteAllNodes();
+        }
+        Node::destroy(nodes, resource);
     }
 
     void insertAtBeginning(int data) {
-        nodes->insertAtBeginning(data, &this->head, &this->tail, this->elementLength);
+        nodes->insertAtBeginning(data, &this->head, &this->tail, this->elementLength, this->resource);
     }
 
     void insertAtEnd(int data) {
-        nodes->insertAtEnd(data, &this->head, &this->tail, this->elementLength);
+        nodes->insertAtEnd(data, &this->head, &this->tail, this->elementLength, this->resource);
     }
 
     void insertAt(unsigned int pos, int data) {
-        nodes->insertAt(pos, data, &this->head, &this->tail, this->elementLength);
+        nodes->insertAt(pos, data, &this->head, &this->tail, this->elementLength, this->resource);
     }
 
     void deleteAtBeginning() {
-        nodes->deleteAtBeginning(&this->head, &this->tail, this->elementLength);
+        nodes->deleteAtBeginning(&this->head, &this->tail, this->elementLength, this->resource);
     }
 
     void deleteAtEnd() {
-        nodes->deleteAtEnd(&this->head, &this->tail, this->elementLength);
+        nodes->deleteAtEnd(&this->head, &this->tail, this->elementLength, this->resource);
     }
 
     void deleteAllNodes() {
-        nodes->deleteAllNodes(&this->head, &this->tail, this->elementLength);
+        nodes->deleteAllNodes(&this->head, &this->tail, this->elementLength, this->resource);
     }
 
     void display() {
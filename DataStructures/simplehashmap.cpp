@@ -1,159 +1,176 @@
+#include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "hashmap.h"
 
-#define TABLE_SIZE 1000
+struct MyKeyHash {
+    uint64_t operator()(const int& k) const
+    {
+        return k % 10;
+    }
+};
 
-template <typename K, typename V>
-class HashNode {
-private:
+int main(int argc, char* argv[]) {
 
-    // key-value pair
-    K key;
-    V value;
+    // HashMap<int, std::string, MyKeyHash> hmap;
+    HashMap<int, std::string> hmap;
+    hmap.put(1, "val1");
+    hmap.put(2, "val2");
+    hmap.put(3, "val3");
 
-    // next bucket with the same key
-    HashNode *next;
+    std::string value;
+    hmap.get(2, value);
+    std::cout << value << std::endl;
 
-public:
-    HashNode(const K& key, const V& value): key(key), value(value), next(NULL) { }
+    hmap.remove(2);
+    std::cout << "after remove, found 2: " << hmap.get(2, value) << std::endl;
 
-    K getKey() const {
-        return key;
-    }
+    // string keys, looked up through a string_view without allocating a std::string
+    HashMap<std::string, int> ports;
+    ports.put("http", 80);
+    ports.put("https", 443);
 
-    V getValue() const {
-        return value;
+    std::string_view request = "https://example.com";
+    int port = 0;
+    if (ports.get(request.substr(0, request.find(':')), port)) {
+        std::cout << "port for " << request << ": " << port << std::endl;
     }
 
-    void setValue(V value) {
-        HashNode::value = value;
+    // in-place access: find() hands out a pointer, insert_or_assign/try_emplace move values in
+    HashMap<std::string, std::vector<std::string>> carts;
+    carts.try_emplace("alice", 1, "book");
+    carts.update("alice", [](std::vector<std::string>& items) { items.push_back("pen"); });
+    if (const auto* items = carts.find(std::string_view("alice"))) {
+        std::cout << "alice has " << items->size() << " items" << std::endl;
     }
 
-    HashNode* getNext() const {
-        return next;
-    }
+    auto elapsed_ms = [](std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    };
 
-    void setNext(HashNode* next) {
-        HashNode::next = next;
-    }
-};
+    // arguments: [random keys] [clustered keys] [records] [record bytes]
 
-template <typename K>
-struct KeyHash {
-    unsigned long operator()(const K& key) const
-    {
-        return static_cast<unsigned long>(key) % TABLE_SIZE;
+    // throughput against std::unordered_map
+    const int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    std::mt19937 rng{42};
+    std::vector<int> keys(n);
+    for (auto& key : keys) {
+        key = static_cast<int>(rng() & 0x7fffffff);
     }
-};
 
-template <typename K, typename V, typename F = KeyHash<K>>
-class HashMap {
-private:
-    HashNode<K, V>** table;
-    F hashFunc;
-
-public:
-    HashMap() {
-        // construct zero initialized hash table of size
-        table = new HashNode<K, V>*[TABLE_SIZE]();
-    }
-
-    ~HashMap() {
-        // destroy all buckets one by one
-        for (int i = 0; i < TABLE_SIZE; ++i) {
-            HashNode<K, V> *entry = table[i];
-            while (entry != NULL) {
-                HashNode<K, V> *prev = entry;
-                entry = entry->getNext();
-                delete prev;
-            }
-            table[i] = NULL;
-        }
-        // destroy the hash table
-        delete [] table;
+    long long checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    HashMap<int, int> map;
+    for (int i = 0; i < n; ++i) {
+        map.put(keys[i], i);
     }
+    long long map_insert = elapsed_ms(start);
 
-    bool get(const K &key, V &value) {
-        unsigned long hashValue = hashFunc(key);
-        HashNode<K, V> *entry = table[hashValue];
-
-        while (entry != NULL) {
-            if (entry->getKey() == key) {
-                value = entry->getValue();
-                return true;
-            }
-            entry = entry->getNext();
-        }
-        return false;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        int found = 0;
+        map.get(keys[i], found);
+        checksum += found;
     }
+    long long map_lookup = elapsed_ms(start);
+
+    // negative keys were never inserted, every lookup misses
+    long long misses = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        int found = 0;
+        misses += !map.get(-keys[i] - 1, found);
+    }
+    long long map_miss = elapsed_ms(start);
 
-    void put(const K &key, const V &value) {
-        unsigned long hashValue = hashFunc(key);
-        HashNode<K, V> *prev = NULL;
-        HashNode<K, V> *entry = table[hashValue];
-
-        while (entry != NULL && entry->getKey() != key) {
-            prev = entry;
-            entry = entry->getNext();
-        }
+    start = std::chrono::steady_clock::now();
+    std::unordered_map<int, int> std_map;
+    for (int i = 0; i < n; ++i) {
+        std_map[keys[i]] = i;
+    }
+    long long std_insert = elapsed_ms(start);
 
-        if (entry == NULL) {
-            entry = new HashNode<K, V>(key, value);
-            if (prev == NULL) {
-                // insert as first bucket
-                table[hashValue] = entry;
-            } else {
-                prev->setNext(entry);
-            }
-        } else {
-            // just update the value
-            entry->setValue(value);
-        }
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        checksum -= std_map.find(keys[i])->second;
     }
+    long long std_lookup = elapsed_ms(start);
 
-    void remove(const K &key) {
-        unsigned long hashValue = hashFunc(key);
-        HashNode<K, V> *prev = NULL;
-        HashNode<K, V> *entry = table[hashValue];
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        misses -= std_map.find(-keys[i] - 1) == std_map.end();
+    }
+    long long std_miss = elapsed_ms(start);
+
+    std::cout << "\n" << n << " random int keys (checksum " << checksum << ", " << misses << ")" << std::endl;
+    std::cout << "  HashMap:            insert " << map_insert << " ms, hit " << map_lookup
+              << " ms, miss " << map_miss << " ms" << std::endl;
+    std::cout << "  std::unordered_map: insert " << std_insert << " ms, hit " << std_lookup
+              << " ms, miss " << std_miss << " ms" << std::endl;
+
+    // MyKeyHash has only 10 distinct values: the keys form probe runs far longer than
+    // kMaxDistance, the table still only grows with its load factor and every insert finishes
+    const int clustered_keys = argc > 2 ? std::atoi(argv[2]) : 20000;
+    start = std::chrono::steady_clock::now();
+    HashMap<int, int, MyKeyHash> clustered;
+    for (int i = 0; i < clustered_keys; ++i) {
+        clustered.put(i, i);
+    }
+    int clustered_found = 0;
+    for (int i = 0; i < clustered_keys; ++i) {
+        int found = -1;
+        clustered_found += clustered.get(i, found) && found == i;
+    }
+    std::cout << "\n" << clustered_keys << " keys with MyKeyHash (k % 10): " << clustered_found
+              << " found, " << elapsed_ms(start) << " ms" << std::endl;
+
+    // multi-KB records: copying get/put against find/update/insert_or_assign
+    const int records = argc > 3 ? std::atoi(argv[3]) : 10000;
+    const int record_size = argc > 4 ? std::atoi(argv[4]) : 4096;
+    HashMap<int, std::string> sessions;
+    for (int i = 0; i < records; ++i) {
+        sessions.put(i, std::string(record_size, 'a'));
+    }
 
-        while (entry != NULL && entry->getKey() != key) {
-            prev = entry;
-            entry = entry->getNext();
+    long long touched = 0;
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < records; ++i) {
+            std::string record;
+            sessions.get(i, record);
+            record[round] = 'b';
+            sessions.put(i, record);
+            touched += record[0];
         }
+    }
+    long long copy_ms = elapsed_ms(start);
 
-        if (entry == NULL) {
-            // key not found
-            return;
-        }
-        else {
-            if (prev == NULL) {
-                // remove first bucket of the list
-                table[hashValue] = entry->getNext();
-            } else {
-                prev->setNext(entry->getNext());
-            }
-            delete entry;
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < records; ++i) {
+            sessions.update(i, [round](std::string& record) { record[round] = 'c'; });
+            touched += (*sessions.find(i))[0];
         }
     }
-};
+    long long in_place_ms = elapsed_ms(start);
 
-struct MyKeyHash {
-    unsigned long operator()(const int& k) const
-    {
-        return k % 10;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < records; ++i) {
+        std::string record(record_size, 'd');
+        sessions.insert_or_assign(i, std::move(record));
     }
-};
-
-int main(int argc, char* argv[]) {
+    long long assign_ms = elapsed_ms(start);
 
-    // HashMap<int, std::string, MyKeyHash> hmap;
-    HashMap<int, std::string> hmap;
-    hmap.put(1, "val1");
-    hmap.put(2, "val2");
-    hmap.put(3, "val3");
+    std::cout << "\n" << records << " records of " << record_size << " bytes, 10 read-modify-write rounds ("
+              << touched << ")" << std::endl;
+    std::cout << "  get + put:           " << copy_ms << " ms" << std::endl;
+    std::cout << "  update + find:       " << in_place_ms << " ms" << std::endl;
+    std::cout << "  insert_or_assign(&&) " << assign_ms << " ms for one round" << std::endl;
 
-    std::string value;
-    hmap.get(2, value);
-    std::cout << value << std::endl;
-    
     return 0;
-}
\ No newline at end of file
+}
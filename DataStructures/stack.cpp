@@ -1,21 +1,21 @@
 #include <iostream>
+#include <memory_resource>
 #include <vector>
 
 class Stack {
 private:
     int size;
     int top;
-    std::vector<int> vec;
+    std::pmr::vector<int> vec;
 
 public:
 
-    Stack(): size{50}, top{0} {
-       vec = std::vector<int>(size, 0);
-    }
+    // the slots come from `resource`, the default memory resource unless one is given
+    explicit Stack(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : size{50}, top{0}, vec(size, 0, resource) {}
 
-    Stack(int size_): size{size_}, top{0} {
-       vec = std::vector<int>(size, 0);
-    }
+    Stack(int size_, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : size{size_}, top{0}, vec(size, 0, resource) {}
 
     void push(int&& value) {
         if (top < size) {
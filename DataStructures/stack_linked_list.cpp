@@ -1,4 +1,5 @@
 #include <iostream>
+#include <memory_resource>
 
 class Node {
 public:
@@ -14,16 +15,28 @@ private:
     int size;
     Node* head;
     Node* tail;
+    std::pmr::memory_resource* resource;
+
+    // nodes come from the list's memory resource instead of new/delete
+    Node* createNode(int value) {
+        return new (resource->allocate(sizeof(Node), alignof(Node))) Node(value);
+    }
+
+    void destroyNode(Node* node) {
+        node->~Node();
+        resource->deallocate(node, sizeof(Node), alignof(Node));
+    }
 
 public:
 
-    LinkedList(): size{0}, head{nullptr}, tail{nullptr} {}
+    explicit LinkedList(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : size{0}, head{nullptr}, tail{nullptr}, resource{resource} {}
     ~LinkedList() {
         Node* current = head;
         while (current != nullptr) {
             Node* temp = current;
             current = current->next;
-            delete temp;
+            destroyNode(temp);
         }
     }
 
@@ -32,7 +45,7 @@ public:
     LinkedList& operator=(const LinkedList&) = delete;
 
     void insert(int&& value) {
-        Node* newNode = new Node(std::move(value));
+        Node* newNode = createNode(std::move(value));
 
         if (head == nullptr && tail == nullptr) {
             head = newNode;
@@ -55,7 +68,7 @@ public:
 
         // data size only 1
         if (head == tail && (head != nullptr || head->next == nullptr)) {
-            delete head;
+            destroyNode(head);
             head = nullptr;
             tail = nullptr;
         }
@@ -64,7 +77,7 @@ public:
         if (head != nullptr && size > 1) {
             Node* to_be_deleted = head;
             head = to_be_deleted->next;
-            delete to_be_deleted;
+            destroyNode(to_be_deleted);
             head->prev = nullptr;
         }
 
@@ -79,7 +92,7 @@ public:
         // data size only 1
         if (tail == head && (head != nullptr || head->next == nullptr)) {
             std::cout << head->value << std::endl;
-            delete head;
+            destroyNode(head);
             head = nullptr;
             tail = nullptr;
         }
@@ -88,7 +101,7 @@ public:
             std::cout << tail->value << std::endl;
             Node* to_be_deleted = tail;
             tail = to_be_deleted->prev;
-            delete to_be_deleted;
+            destroyNode(to_be_deleted);
             tail->next = nullptr;
         }
 
@@ -113,7 +126,7 @@ public:
                 }
                 current->prev->next = current->next;
                 current->next->prev = current->prev;
-                delete current;
+                destroyNode(current);
             }
         }
 
@@ -146,8 +159,9 @@ private:
     LinkedList* list;
 
 public:
-    Stack(int size_): top{0}, size{size_} {
-        list = new LinkedList();
+    Stack(int size_, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : top{0}, size{size_} {
+        list = new LinkedList(resource);
     }
 
     ~Stack() {
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include "numa.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+// Arena (region) memory resource for request-scoped allocation:
+// Allocation is a pointer bump inside the current chunk and deallocate does nothing;
+// memory only comes back in bulk, through rewind(checkpoint) or release().
+// - checkpoint() remembers the current position, rewind() drops everything allocated since,
+//   so scopes can nest: a request takes a checkpoint, a sub-task takes another one, and each
+//   rewinds its own part (ArenaScope does this with RAII).
+// - When a chunk is full the next one is twice as large (up to max_chunk), so a big request
+//   needs only a few chunks.
+// - Chunks dropped by a rewind are kept on a recycle list and reused by later requests
+//   instead of being unmapped and mapped again; trim() gives them back to the OS.
+// - With huge_pages, chunks are rounded to 2 MB and mapped with MAP_HUGETLB where the
+//   system has reserved huge pages, otherwise they are marked for transparent huge pages.
+// - With a numa_node, every chunk is placed on that node (see numa.h); together with
+//   pinThreadToNode a worker's request memory stays on its own socket.
+// Not thread-safe: use one arena per thread (or per request).
+
+class ArenaResource : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t kHugePageSize = std::size_t{2} << 20;
+
+    struct Chunk {
+        Chunk* prev;        // the chunk before this one in the arena, or the next recycled one
+        std::size_t size;   // bytes including this header
+    };
+
+    // opaque position inside the arena, see rewind()
+    struct Checkpoint {
+        Chunk* chunk;
+        char* position;
+    };
+
+    explicit ArenaResource(std::size_t first_chunk = 64 << 10, bool huge_pages = false,
+                           std::size_t max_chunk = 64 << 20, int numa_node = -1)
+        : next_chunk_size(first_chunk < 4096 ? 4096 : first_chunk), max_chunk_size(max_chunk),
+          huge_pages(huge_pages), numa_node(numa_node), current(nullptr), recycled(nullptr),
+          position(nullptr), end(nullptr), reserved(0), chunks(0) {}
+
+    ArenaResource(const ArenaResource&) = delete;
+    ArenaResource& operator=(const ArenaResource&) = delete;
+
+    ~ArenaResource() override {
+        release();
+        trim();
+    }
+
+    Checkpoint checkpoint() const {
+        return {current, position};
+    }
+
+    // frees everything allocated after `mark`; checkpoints taken after `mark` become invalid
+    void rewind(Checkpoint mark) {
+        while (current != mark.chunk) {
+            Chunk* chunk = current;
+            current = chunk->prev;
+            chunk->prev = recycled;
+            recycled = chunk;
+        }
+        position = mark.position;
+        end = current == nullptr ? nullptr : reinterpret_cast<char*>(current) + current->size;
+    }
+
+    // frees everything, the chunks stay around for reuse
+    void release() {
+        rewind({nullptr, nullptr});
+    }
+
+    // gives the recycled chunks back to the OS
+    void trim() {
+        while (recycled != nullptr) {
+            Chunk* chunk = recycled;
+            recycled = chunk->prev;
+            reserved -= chunk->size;
+            chunks--;
+            unmapChunk(chunk, chunk->size);
+        }
+    }
+
+    std::size_t reservedBytes() const { return reserved; }
+    std::size_t chunkCount() const { return chunks; }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        char* p = alignUp(position, alignment);
+        if (p == nullptr || p + bytes > end) {
+            nextChunk(bytes + alignment);
+            p = alignUp(position, alignment);
+        }
+        position = p + bytes;
+        return p;
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    static char* alignUp(char* p, std::size_t alignment) {
+        uintptr_t address = reinterpret_cast<uintptr_t>(p);
+        return reinterpret_cast<char*>((address + alignment - 1) & ~(alignment - 1));
+    }
+
+    // makes a chunk with at least `needed` free bytes the current one
+    void nextChunk(std::size_t needed) {
+        needed += sizeof(Chunk);
+
+        // a recycled chunk that is large enough first, no system call
+        Chunk** link = &recycled;
+        while (*link != nullptr && (*link)->size < needed) {
+            link = &(*link)->prev;
+        }
+
+        Chunk* chunk = *link;
+        if (chunk != nullptr) {
+            *link = chunk->prev;
+        } else {
+            std::size_t size = next_chunk_size;
+            while (size < needed) {
+                size *= 2;
+            }
+            if (huge_pages) {
+                size = (size + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+            }
+            chunk = static_cast<Chunk*>(mapChunk(size, huge_pages, numa_node));
+            chunk->size = size;
+            reserved += size;
+            chunks++;
+            if (next_chunk_size < max_chunk_size) {
+                next_chunk_size *= 2;
+            }
+        }
+
+        chunk->prev = current;
+        current = chunk;
+        position = reinterpret_cast<char*>(chunk) + sizeof(Chunk);
+        end = reinterpret_cast<char*>(chunk) + chunk->size;
+    }
+
+    static void* mapChunk(std::size_t size, bool huge_pages, int numa_node) {
+#if defined(__linux__)
+        void* p = MAP_FAILED;
+#if defined(MAP_HUGETLB)
+        if (huge_pages) {
+            p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        }
+#endif
+        if (p == MAP_FAILED) {
+            p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+#if defined(MADV_HUGEPAGE)
+            if (huge_pages) {
+                madvise(p, size, MADV_HUGEPAGE);
+            }
+#endif
+        }
+        numaBind(p, size, numa_node);
+        return p;
+#else
+        (void)huge_pages;
+        (void)numa_node;
+        return ::operator new(size);
+#endif
+    }
+
+    static void unmapChunk(void* p, std::size_t size) {
+#if defined(__linux__)
+        munmap(p, size);
+#else
+        (void)size;
+        ::operator delete(p);
+#endif
+    }
+
+    std::size_t next_chunk_size;
+    std::size_t max_chunk_size;
+    bool huge_pages;
+    int numa_node;
+    Chunk* current;
+    Chunk* recycled;
+    char* position;
+    char* end;
+    std::size_t reserved;
+    std::size_t chunks;
+};
+
+// checkpoint on construction, rewind on destruction
+class ArenaScope {
+public:
+    explicit ArenaScope(ArenaResource& arena): arena(arena), mark(arena.checkpoint()) {}
+    ~ArenaScope() { arena.rewind(mark); }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    ArenaResource& arena;
+    ArenaResource::Checkpoint mark;
+};
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+#include "numa.h"
+
+// Fixed-size object pool:
+// Memory is taken from the global heap in chunks, and each chunk is cut into equal blocks.
+// A freed block is pushed onto an intrusive free list (the "next" pointer is stored inside
+// the free block itself), and allocate pops from that list first, so blocks are reused in
+// any order and both operations are O(1). Blocks that were never handed out are carved from
+// the newest chunk with a bump pointer. When everything is in use the pool grows by a new
+// chunk, twice as large as the previous one (up to kMaxChunkBlocks), instead of falling back
+// to ::operator new per object. Chunks are only given back when the pool is destroyed.
+// With a numa_node, chunks are mapped on that node (see numa.h) instead of coming from the heap.
+
+class FixedPool {
+private:
+    static constexpr std::size_t kMaxChunkBlocks = 1 << 16;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    std::size_t block_size;
+    std::size_t alignment;
+    std::size_t next_chunk_blocks;
+    std::vector<std::pair<void*, std::size_t>> chunks;   // address and size in bytes
+    FreeBlock* free_list;
+    char* bump;           // next never-used block in the newest chunk
+    char* bump_end;
+    std::size_t in_use;
+    std::size_t reserved_bytes;
+    int numa_node;        // -1: chunks from ::operator new
+
+public:
+    FixedPool(std::size_t object_size, std::size_t object_alignment = alignof(std::max_align_t),
+              std::size_t first_chunk_blocks = 64, int numa_node = -1)
+        : alignment(object_alignment < alignof(FreeBlock) ? alignof(FreeBlock) : object_alignment),
+          next_chunk_blocks(first_chunk_blocks == 0 ? 1 : first_chunk_blocks),
+          free_list(nullptr), bump(nullptr), bump_end(nullptr), in_use(0), reserved_bytes(0), numa_node(numa_node)
+    {
+        // a block has to hold the free list link and keep every block in the chunk aligned
+        std::size_t size = object_size < sizeof(FreeBlock) ? sizeof(FreeBlock) : object_size;
+        block_size = (size + alignment - 1) / alignment * alignment;
+    }
+
+    FixedPool(const FixedPool&) = delete;
+    FixedPool& operator=(const FixedPool&) = delete;
+
+    ~FixedPool() {
+        for (auto& [chunk, bytes] : chunks) {
+            if (numa_node >= 0) {
+                numaUnmapChunk(chunk, bytes);
+            } else {
+                ::operator delete(chunk, std::align_val_t(alignment));
+            }
+        }
+    }
+
+    void* allocate() {
+        in_use++;
+        if (free_list != nullptr) {
+            FreeBlock* block = free_list;
+            free_list = block->next;
+            return block;
+        }
+        if (bump == bump_end) {
+            grow();
+        }
+        void* block = bump;
+        bump += block_size;
+        return block;
+    }
+
+    void deallocate(void* p) {
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        block->next = free_list;
+        free_list = block;
+        in_use--;
+    }
+
+    std::size_t blockSize() const { return block_size; }
+    std::size_t blocksInUse() const { return in_use; }
+    std::size_t chunkCount() const { return chunks.size(); }
+    std::size_t reservedBytes() const { return reserved_bytes; }
+
+private:
+    void grow() {
+        std::size_t bytes = next_chunk_blocks * block_size;
+        // mapped chunks are page aligned, which covers any block alignment up to 4 KB
+        void* chunk = numa_node >= 0 ? numaMapChunk(bytes, numa_node)
+                                     : ::operator new(bytes, std::align_val_t(alignment));
+        chunks.emplace_back(chunk, bytes);
+        reserved_bytes += bytes;
+        bump = static_cast<char*>(chunk);
+        bump_end = bump + bytes;
+        if (next_chunk_blocks < kMaxChunkBlocks) {
+            next_chunk_blocks *= 2;
+        }
+    }
+};
+
+// One FixedPool per block size and alignment, shared by every PoolAllocator that needs it.
+// Not thread-safe: a container using PoolAllocator has to stay on one thread.
+template <std::size_t Size, std::size_t Align>
+FixedPool& sharedPool() {
+    static FixedPool pool{Size, Align};
+    return pool;
+}
+
+// Standard allocator on top of the shared pools. Node-based containers (std::list, std::map,
+// std::set, ...) allocate one node at a time, which comes from the pool for the node's size;
+// requests for several objects at once (std::vector) go straight to ::operator new.
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        if (n == 1) {
+            return static_cast<T*>(sharedPool<sizeof(T), alignof(T)>().allocate());
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        if (n == 1) {
+            sharedPool<sizeof(T), alignof(T)>().deallocate(p);
+            return;
+        }
+        ::operator delete(p, std::align_val_t(alignof(T)));
+    }
+
+    // the pools are global, so any two PoolAllocators can free each other's memory
+    template <typename U>
+    bool operator == (const PoolAllocator<U>&) const noexcept { return true; }
+
+    template <typename U>
+    bool operator != (const PoolAllocator<U>&) const noexcept { return false; }
+};
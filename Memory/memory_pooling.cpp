@@ -1,111 +1,104 @@
+#include <chrono>
 #include <iostream>
-#include <memory>
+#include <list>
+#include <map>
+#include <random>
 #include <vector>
-
-template <typename T>
-class PoolAllocator {
-private:
-    T* pool;              // Raw pointer to the beginning of the pool
-    std::size_t pool_size; // Total number of T elements in the pool
-    std::size_t used;     // How many T elements are currently 'in use'
-
-public:
-    using value_type = T;
-
-    // Constructor: allocate a pool for `pool_size` Ts
-    explicit PoolAllocator(std::size_t pool_size)
-        : pool(nullptr), pool_size(pool_size), used(0)
-    {
-        // Allocate raw memory for the pool
-        pool = static_cast<T*>(::operator new(pool_size * sizeof(T)));
-    }
-
-    // Prevent copying (simple pool allocator typically doesn't support copy semantics)
-    PoolAllocator(const PoolAllocator&) = delete;
-    PoolAllocator& operator=(const PoolAllocator&) = delete;
-
-    // Allocate n Ts
-    T* allocate(std::size_t n) {
-        // If we have enough space left in the pool
-        if (used + n <= pool_size) {
-            T* result = pool + used;
-            used += n;
-            return result;
-        }
-        // Otherwise, fall back to the global operator new
-        return static_cast<T*>(::operator new(n * sizeof(T)));
-    }
-
-    // Deallocate n Ts
-    void deallocate(T* p, std::size_t n) {
-        // Check if p is within the pool range
-        if (p >= pool && p < pool + pool_size) {
-            // If this pointer is exactly the last allocated block,
-            // then we can reclaim it by adjusting `used`.
-            // In pointer arithmetic: p + n must be the current top (pool + used).
-            if (p + n == pool + used) {
-                used -= n;
-            }
-            // Otherwise, we do nothing. (No partial "freeing" in a naive stack approach.)
+#include "memory_pool.h"
+
+// node churn: keep a container at about `live` elements while inserting and erasing at random
+template <typename Map>
+long long churn(int live, int operations) {
+    std::mt19937 rng{42};
+    Map map;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < operations; ++i) {
+        int key = static_cast<int>(rng() % (2 * live));
+        if (rng() % 2 == 0) {
+            map[key] = i;
         } else {
-            // If not in the pool, it was allocated on the heap -> free it
-            ::operator delete(p);
+            map.erase(key);
         }
     }
-
-    // Destructor frees the entire pool
-    ~PoolAllocator() {
-        ::operator delete(pool);
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// frees and reallocates random blocks out of `live` outstanding ones, through alloc/free
+template <typename Alloc, typename Free>
+long long randomOrder(int live, int operations, Alloc alloc, Free release) {
+    std::mt19937 rng{7};
+    std::vector<void*> blocks(live);
+    for (auto& block : blocks) {
+        block = alloc();
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < operations; ++i) {
+        void*& block = blocks[rng() % live];
+        release(block);
+        block = alloc();
     }
-};
+    long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    for (auto& block : blocks) {
+        release(block);
+    }
+    return ms;
+}
 
-int main() {
-    PoolAllocator<int> alloc{10};
+int main(int argc, char* argv[]) {
+    FixedPool pool{sizeof(int) * 5, alignof(int), 2};
 
-    // 1. Allocate 5 ints (within the pool)
-    int* p1 = alloc.allocate(5);
+    // 1. Allocate three blocks of 5 ints, the third one makes the pool grow a second chunk
+    int* p1 = static_cast<int*>(pool.allocate());
+    int* p2 = static_cast<int*>(pool.allocate());
+    int* p3 = static_cast<int*>(pool.allocate());
     for (int i = 0; i < 5; ++i) {
         p1[i] = i + 100;
-    }
-
-    // 2. Allocate another 5 ints (fills the pool completely)
-    int* p2 = alloc.allocate(5);
-    for (int i = 0; i < 5; ++i) {
         p2[i] = i + 200;
+        p3[i] = i + 300;
     }
-
-    // Print out both blocks
-    std::cout << "Block p1 (5 ints): ";
-    for (int i = 0; i < 5; ++i) {
-        std::cout << p1[i] << " ";
-    }
-    std::cout << "\nBlock p2 (5 ints): ";
-    for (int i = 0; i < 5; ++i) {
-        std::cout << p2[i] << " ";
+    std::cout << "3 blocks in use, " << pool.chunkCount() << " chunks\n";
+
+    // 2. Free the first block, not the last one: the next allocation reuses it anyway
+    pool.deallocate(p1);
+    int* p4 = static_cast<int*>(pool.allocate());
+    std::cout << "Freed block reused: " << (p4 == p1 ? "yes" : "no") << "\n";
+
+    pool.deallocate(p2);
+    pool.deallocate(p3);
+    pool.deallocate(p4);
+    std::cout << "Blocks in use after freeing all: " << pool.blocksInUse() << "\n";
+
+    // 3. Node-based containers through PoolAllocator
+    std::list<int, PoolAllocator<int>> numbers{1, 2, 3};
+    numbers.remove(2);
+    numbers.push_back(4);
+    std::cout << "List:";
+    for (int n : numbers) {
+        std::cout << " " << n;
     }
     std::cout << "\n";
 
-    // 3. Deallocate p2 first (the last allocated block)
-    //    This should free up space for another 5 ints in the pool
-    alloc.deallocate(p2, 5);
+    const int live = argc > 1 ? std::atoi(argv[1]) : 10000;
+    const int operations = argc > 2 ? std::atoi(argv[2]) : 5000000;
 
-    // 4. Now allocate 5 more ints again from the pool
-    int* p3 = alloc.allocate(5);
-    for (int i = 0; i < 5; ++i) {
-        p3[i] = i + 300;
-    }
+    using PooledMap = std::map<int, int, std::less<int>, PoolAllocator<std::pair<const int, int>>>;
+    long long std_ms = churn<std::map<int, int>>(live, operations);
+    long long pool_ms = churn<PooledMap>(live, operations);
 
-    std::cout << "Block p3 (5 ints after reuse): ";
-    for (int i = 0; i < 5; ++i) {
-        std::cout << p3[i] << " ";
-    }
-    std::cout << "\n";
+    std::cout << "\nstd::map churn, ~" << live << " live nodes, " << operations << " inserts/erases\n";
+    std::cout << "  std::allocator: " << std_ms << " ms\n";
+    std::cout << "  PoolAllocator:  " << pool_ms << " ms\n";
+
+    // the allocator alone: 48 byte blocks freed in random order
+    FixedPool blocks{48};
+    long long new_ms = randomOrder(live, operations, [] { return ::operator new(48); },
+                                   [](void* p) { ::operator delete(p); });
+    long long fixed_ms = randomOrder(live, operations, [&blocks] { return blocks.allocate(); },
+                                     [&blocks](void* p) { blocks.deallocate(p); });
 
-    // 5. Deallocate p3, then p1
-    //    p3 is still the last allocated block, so it will be freed. 
-    //    But p1 won't be freed because it's not the "top" of the stack anymore.
-    alloc.deallocate(p3, 5); // Reclaims memory in the pool
-    alloc.deallocate(p1, 5); // Does nothing for p1 in a strict LIFO approach
+    std::cout << "\n48 byte blocks, " << live << " live, " << operations << " random frees + allocations\n";
+    std::cout << "  new/delete: " << new_ms << " ms\n";
+    std::cout << "  FixedPool:  " << fixed_ms << " ms\n";
 
     return 0;
-}
\ No newline at end of file
+}
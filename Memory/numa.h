@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// NUMA placement helpers for the memory resources in Memory/:
+// - numaMapChunk maps a chunk and asks the kernel to place its pages on one node (mbind with
+//   MPOL_PREFERRED, so a full node spills over instead of failing), before anything touches it
+// - pinThreadToNode keeps the calling thread on that node's CPUs, so a worker and the memory
+//   it allocates stay on the same socket
+// Nodes and their CPUs are read from /sys/devices/system/node; mbind is called through
+// syscall(), so there is no libnuma dependency. On single-node machines and on other systems
+// every call is a graceful no-op and chunks come from plain mmap / ::operator new.
+
+inline std::vector<int> parseCpuList(const std::string& list) {
+    // "0-3,8,10-11"
+    std::vector<int> cpus;
+    std::stringstream ranges(list);
+    std::string range;
+    while (std::getline(ranges, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+        std::size_t dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+inline std::string readSysfs(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+// number of NUMA nodes, 1 when the system does not say
+inline int numaNodeCount() {
+    static const int count = [] {
+        std::vector<int> nodes = parseCpuList(readSysfs("/sys/devices/system/node/online"));
+        return nodes.empty() ? 1 : nodes.back() + 1;
+    }();
+    return count;
+}
+
+inline std::vector<int> numaNodeCpus(int node) {
+    return parseCpuList(readSysfs("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"));
+}
+
+// node of the CPU the calling thread runs on right now, 0 when unknown
+inline int currentNumaNode() {
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+        return static_cast<int>(node);
+    }
+#endif
+    return 0;
+}
+
+// restricts the calling thread to the CPUs of `node`; false when that is not possible
+inline bool pinThreadToNode(int node) {
+#if defined(__linux__)
+    std::vector<int> cpus = numaNodeCpus(node);
+    if (cpus.empty()) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        CPU_SET(cpu, &set);
+    }
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+// prefers `node` for the pages of [p, p + bytes); true when the policy was set
+inline bool numaBind(void* p, std::size_t bytes, int node) {
+#if defined(__linux__) && defined(SYS_mbind)
+    if (node < 0 || numaNodeCount() <= 1) {
+        return false;
+    }
+    constexpr int kPreferred = 1;   // MPOL_PREFERRED
+    constexpr int kBitsPerWord = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> mask(node / kBitsPerWord + 1, 0);
+    mask[node / kBitsPerWord] = 1ul << (node % kBitsPerWord);
+    // the kernel reads maxnode - 1 bits
+    unsigned long max_node = mask.size() * kBitsPerWord + 1;
+    return syscall(SYS_mbind, p, bytes, kPreferred, mask.data(), max_node, 0) == 0;
+#else
+    (void)p;
+    (void)bytes;
+    (void)node;
+    return false;
+#endif
+}
+
+// page-aligned chunk whose pages are placed on `node` (any node when node < 0)
+inline void* numaMapChunk(std::size_t bytes, int node) {
+#if defined(__linux__)
+    void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    numaBind(p, bytes, node);
+    return p;
+#else
+    (void)node;
+    return ::operator new(bytes);
+#endif
+}
+
+inline void numaUnmapChunk(void* p, std::size_t bytes) {
+#if defined(__linux__)
+    munmap(p, bytes);
+#else
+    (void)bytes;
+    ::operator delete(p);
+#endif
+}
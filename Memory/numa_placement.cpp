@@ -0,0 +1,84 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+#include "arena_resource.h"
+#include "numa.h"
+#include "pool_resource.h"
+
+// Local against remote memory: each worker pins itself to a node, then scans one buffer
+// allocated on its own node and one allocated on the next node over.
+// With a single node both buffers are the same memory and the numbers should match; a
+// multi-node layout can be emulated on x86 Linux by booting with numa=fake=2.
+
+// sums the buffer `passes` times and returns GB/s
+double scan(const std::pmr::vector<uint64_t>& buffer, int passes, uint64_t& sink) {
+    auto start = std::chrono::steady_clock::now();
+    uint64_t sum = 0;
+    for (int pass = 0; pass < passes; ++pass) {
+        for (uint64_t value : buffer) {
+            sum += value;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    sink += sum;
+    return static_cast<double>(buffer.size() * sizeof(uint64_t)) * passes / seconds / 1e9;
+}
+
+int main(int argc, char* argv[]) {
+    const int nodes = numaNodeCount();
+    const int workers = argc > 1 ? std::atoi(argv[1]) : nodes;
+    const std::size_t megabytes = argc > 2 ? std::atoll(argv[2]) : 64;
+    const int passes = argc > 3 ? std::atoi(argv[3]) : 10;
+
+    std::cout << nodes << " NUMA node(s)" << std::endl;
+    for (int node = 0; node < nodes; ++node) {
+        std::cout << "  node " << node << ": " << numaNodeCpus(node).size() << " CPUs" << std::endl;
+    }
+
+    // a node-local PoolResource for one worker's containers
+    PoolResource local_pool{std::pmr::new_delete_resource(), 0};
+    std::pmr::vector<int> ids{&local_pool};
+    ids.assign({1, 2, 3});
+    std::cout << "pool on node 0 holds " << ids.size() << " ids, main thread runs on node "
+              << currentNumaNode() << std::endl;
+
+    std::cout << "\n" << workers << " worker(s), " << megabytes << " MB buffers, " << passes << " passes" << std::endl;
+    std::atomic<uint64_t> sink{0};
+    std::vector<std::thread> threads;
+    for (int w = 0; w < workers; ++w) {
+        threads.emplace_back([=, &sink] {
+            int node = w % nodes;
+            int remote = (node + 1) % nodes;
+            bool pinned = pinThreadToNode(node);
+
+            const std::size_t count = megabytes * (1 << 20) / sizeof(uint64_t);
+            ArenaResource local_arena{64 << 10, false, 64 << 20, node};
+            ArenaResource remote_arena{64 << 10, false, 64 << 20, remote};
+            // filled by this thread: the first touch happens after the chunk was bound
+            std::pmr::vector<uint64_t> local(count, 1, &local_arena);
+            std::pmr::vector<uint64_t> far(count, 1, &remote_arena);
+
+            uint64_t sum = 0;
+            double local_rate = scan(local, passes, sum);
+            double remote_rate = scan(far, passes, sum);
+            sink += sum;
+
+            std::string line = "  worker " + std::to_string(w) + (pinned ? " pinned to node " : " unpinned, node ")
+                             + std::to_string(currentNumaNode()) + ": local (node " + std::to_string(node) + ") "
+                             + std::to_string(local_rate) + " GB/s, remote (node " + std::to_string(remote) + ") "
+                             + std::to_string(remote_rate) + " GB/s\n";
+            std::cout << line;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return sink.load() == 0 ? 1 : 0;
+}
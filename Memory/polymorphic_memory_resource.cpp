@@ -1,6 +1,10 @@
+#include <chrono>
 #include <iostream>
+#include <map>
+#include <string>
 #include <vector>
 #include <memory_resource>
+#include "arena_resource.h"
 
 /*
 A Polymorphic Memory Resource (PMR) is a part of the C++ standard library introduced in C++17 as part of the C++ Standard Library Extensions (often associated with C++20). The purpose of a Polymorphic Memory Resource is to provide a flexible and efficient way to manage memory allocation in C++ programs, especially for custom memory management strategies, without requiring the use of fixed memory allocation strategies tied to specific containers or other components.
@@ -8,7 +12,35 @@ A Polymorphic Memory Resource (PMR) is a part of the C++ standard library introd
 In simpler terms, PMRs allow you to manage memory allocation in a polymorphic (i.e., runtime-configurable) manner, making it possible to swap out different memory management strategies during execution.
 */
 
-int main() {
+// one request: parse some headers and build a response out of pmr containers
+std::size_t handleRequest(std::pmr::memory_resource* resource, int fields) {
+    std::pmr::map<std::pmr::string, std::pmr::string> headers{resource};
+    for (int i = 0; i < fields; ++i) {
+        std::pmr::string name{"x-header-field-number-", resource};
+        name += std::to_string(i);
+        headers.emplace(std::move(name), std::pmr::string(64, 'v', resource));
+    }
+
+    std::pmr::vector<std::pmr::string> lines{resource};
+    for (auto& header : headers) {
+        std::pmr::string line{header.first, resource};
+        line += ": ";
+        line += header.second;
+        lines.push_back(std::move(line));
+    }
+    return lines.size();
+}
+
+template <typename Run>
+long long timeRequests(int requests, Run run) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < requests; ++r) {
+        run();
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
     // Create a memory resource
     std::pmr::monotonic_buffer_resource pool_resource{1024}; // 1 KB pool
 
@@ -23,6 +55,44 @@ int main() {
     for (const auto& el : vec) {
         std::cout << el << " ";
     }
+    std::cout << "\n";
+
+    // Nested scopes on an arena: the inner scope is rewound, the outer one keeps its data
+    ArenaResource arena;
+    std::pmr::vector<int> kept{&arena};
+    kept.assign({1, 2, 3});
+    {
+        ArenaScope scratch{arena};
+        std::pmr::vector<int> temporary(100000, 7, &arena);
+        std::cout << "Inside scope: " << arena.chunkCount() << " chunks, "
+                  << arena.reservedBytes() / 1024 << " KB reserved\n";
+    }
+    kept.push_back(4);   // reuses the space the scope gave back
+    std::cout << "After scope: kept " << kept.size() << " elements, chunks are recycled, not unmapped ("
+              << arena.reservedBytes() / 1024 << " KB reserved)\n";
+
+    const int requests = argc > 1 ? std::atoi(argv[1]) : 20000;
+    const int fields = argc > 2 ? std::atoi(argv[2]) : 100;
+    const bool huge_pages = argc > 3 && std::atoi(argv[3]) != 0;
+
+    long long heap_ms = timeRequests(requests, [fields] {
+        handleRequest(std::pmr::new_delete_resource(), fields);
+    });
+    long long monotonic_ms = timeRequests(requests, [fields] {
+        std::pmr::monotonic_buffer_resource per_request{64 << 10};
+        handleRequest(&per_request, fields);
+    });
+    ArenaResource requestArena{64 << 10, huge_pages};
+    long long arena_ms = timeRequests(requests, [&requestArena, fields] {
+        ArenaScope request{requestArena};
+        handleRequest(&requestArena, fields);
+    });
+
+    std::cout << "\n" << requests << " requests, " << fields << " headers each\n";
+    std::cout << "  new/delete:                           " << heap_ms << " ms\n";
+    std::cout << "  monotonic_buffer_resource per request: " << monotonic_ms << " ms\n";
+    std::cout << "  ArenaResource + rewind:               " << arena_ms << " ms ("
+              << requestArena.chunkCount() << " chunks mapped in total)\n";
 
     return 0;
-}
\ No newline at end of file
+}
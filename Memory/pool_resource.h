@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <ostream>
+#include "memory_pool.h"
+
+// Size-class pooled memory_resource:
+// Requests up to kMaxPooledSize bytes are rounded up to a size class and served from that
+// class's FixedPool (free list + chunked growth), so node-sized allocations of every
+// container share a few pools instead of hitting the global heap one by one. Larger or
+// over-aligned requests are passed to the upstream resource.
+// Installing it with std::pmr::set_default_resource moves every container that was built
+// with the default resource (LinkedList, Stack, BTree, Trie, HashMap, Heap, std::pmr::*)
+// into the pools at once. Not thread-safe, like std::pmr::unsynchronized_pool_resource.
+// Given a numa_node, the pools' chunks are placed on that node; upstream requests are not.
+
+class PoolResource : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t kClassSizes[] = {
+        16, 32, 48, 64, 80, 96, 112, 128,
+        160, 192, 224, 256, 320, 384, 448, 512,
+        640, 768, 896, 1024, 1536, 2048, 3072, 4096,
+    };
+    static constexpr int kClassCount = sizeof(kClassSizes) / sizeof(kClassSizes[0]);
+    static constexpr std::size_t kMaxPooledSize = kClassSizes[kClassCount - 1];
+    static constexpr std::size_t kAlignment = 16;
+
+    explicit PoolResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource(), int numa_node = -1)
+        : upstream_resource(upstream), requested_bytes(0), upstream_bytes(0)
+    {
+        for (int cls = 0; cls < kClassCount; ++cls) {
+            pools[cls] = new FixedPool(kClassSizes[cls], kAlignment, 64, numa_node);
+        }
+    }
+
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+
+    ~PoolResource() override {
+        for (FixedPool* pool : pools) {
+            delete pool;
+        }
+    }
+
+    // bytes the callers asked for and still hold
+    std::size_t requestedBytes() const { return requested_bytes; }
+
+    // bytes taken from the system: pool chunks plus pass-through allocations
+    std::size_t reservedBytes() const {
+        std::size_t total = upstream_bytes;
+        for (const FixedPool* pool : pools) {
+            total += pool->reservedBytes();
+        }
+        return total;
+    }
+
+    void report(std::ostream& out) const {
+        out << "  class   blocks in use   chunks   reserved" << std::endl;
+        for (int cls = 0; cls < kClassCount; ++cls) {
+            if (pools[cls]->chunkCount() == 0) {
+                continue;
+            }
+            out << "  " << kClassSizes[cls] << "\t" << pools[cls]->blocksInUse() << "\t\t"
+                << pools[cls]->chunkCount() << "\t " << pools[cls]->reservedBytes() << std::endl;
+        }
+        out << "  requested " << requestedBytes() << " bytes, reserved " << reservedBytes() << " bytes" << std::endl;
+    }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        requested_bytes += bytes;
+        if (bytes > kMaxPooledSize || alignment > kAlignment) {
+            upstream_bytes += bytes;
+            return upstream_resource->allocate(bytes, alignment);
+        }
+        return pools[sizeClass(bytes)]->allocate();
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        requested_bytes -= bytes;
+        if (bytes > kMaxPooledSize || alignment > kAlignment) {
+            upstream_bytes -= bytes;
+            upstream_resource->deallocate(p, bytes, alignment);
+            return;
+        }
+        pools[sizeClass(bytes)]->deallocate(p);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    // smallest class that fits: direct for the 16 byte steps, a binary search above
+    static int sizeClass(std::size_t bytes) {
+        if (bytes <= 128) {
+            return bytes == 0 ? 0 : static_cast<int>((bytes - 1) / 16);
+        }
+        int low = 8;
+        int high = kClassCount - 1;
+        while (low < high) {
+            int middle = (low + high) / 2;
+            if (kClassSizes[middle] < bytes) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        return low;
+    }
+
+    std::pmr::memory_resource* upstream_resource;
+    FixedPool* pools[kClassCount];
+    std::size_t requested_bytes;
+    std::size_t upstream_bytes;
+};
@@ -0,0 +1,92 @@
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include "pool_resource.h"
+#include "../DataStructures/hashmap.h"
+#include "../Tree/heap.h"
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+// One deployment switch: every container below is built with the default memory resource,
+// so std::pmr::set_default_resource(&pool) moves all of their allocations into PoolResource
+// without touching the code that uses them.
+
+// a mixed service-like workload: an index, a priority queue of jobs and a list of sessions,
+// all churning at the same time so their blocks interleave on the heap;
+// report() runs at the end while the containers are still alive
+template <typename Report>
+long long workload(int operations, int live, Report report) {
+    std::mt19937 rng{42};
+    auto start = std::chrono::steady_clock::now();
+
+    HashMap<int, int> index;
+    Heap<TaskRecord> jobs;
+    std::pmr::map<int, std::pmr::string> names;
+    std::pmr::list<int> sessions;
+
+    for (int i = 0; i < operations; ++i) {
+        int key = static_cast<int>(rng() % live);
+        switch (rng() % 4) {
+        case 0:
+            index.put(key, i);
+            names.emplace(key, "session name that does not fit in SSO");
+            break;
+        case 1:
+            index.remove(key);
+            names.erase(key);
+            break;
+        case 2:
+            jobs.heapInsert(TaskRecord(rng() % 1000, "job"));
+            sessions.push_back(key);
+            break;
+        default:
+            if (!jobs.empty()) {
+                jobs.heapRemoveMax();
+            }
+            if (!sessions.empty()) {
+                sessions.pop_front();
+            }
+            break;
+        }
+    }
+
+    long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    report();
+    return ms;
+}
+
+int main(int argc, char* argv[]) {
+    const int operations = argc > 1 ? std::atoi(argv[1]) : 2000000;
+    const int live = argc > 2 ? std::atoi(argv[2]) : 50000;
+
+    std::cout << "new/delete at the end of the run:" << std::endl;
+    long long heap_ms = workload(operations, live, [] {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+        // fordblks: bytes malloc holds in free chunks, i.e. the fragmentation
+        struct mallinfo2 info = mallinfo2();
+        std::cout << "  in use " << info.uordblks << " bytes, free but held " << info.fordblks
+                  << " bytes, mmapped " << info.hblkhd << " bytes" << std::endl;
+#else
+        std::cout << "  (no malloc statistics on this platform)" << std::endl;
+#endif
+    });
+
+    PoolResource pool;
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(&pool);
+    std::cout << "\nPoolResource at the end of the run:" << std::endl;
+    long long pool_ms = workload(operations, live, [&pool] { pool.report(std::cout); });
+    std::pmr::set_default_resource(previous);
+
+    std::cout << "\n" << operations << " operations on HashMap, Heap, pmr::map and pmr::list, "
+              << live << " keys" << std::endl;
+    std::cout << "  new/delete:   " << heap_ms << " ms" << std::endl;
+    std::cout << "  PoolResource: " << pool_ms << " ms" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// Immutable, reference-counted byte buffer for passing payloads through a pipeline:
+// - copying a SharedBytes copies a pointer and bumps an atomic count, never the bytes
+// - slice() is O(1): the slice points into the same buffer and keeps it alive, so a record cut
+//   out of a payload stays valid after the payload itself is dropped
+// - it converts to std::string_view for code that only reads
+// The count and the bytes share one allocation (a Block header in front of the data).
+// The count is incremented with relaxed ordering; the decrement that frees uses acq_rel, so
+// every reader's accesses happen before the buffer is deleted. The last owner frees without
+// any atomic read-modify-write at all.
+// The bytes are never written after construction, so any number of threads may read the
+// same buffer; a single SharedBytes object is not meant to be assigned from two threads.
+
+class SharedBytes {
+private:
+    struct Block {
+        std::atomic<std::size_t> refs;
+        std::size_t size;
+
+        char* bytes() { return reinterpret_cast<char*>(this + 1); }
+    };
+
+    Block* block;
+    const char* start;
+    std::size_t length;
+
+    SharedBytes(Block* block, const char* start, std::size_t length) noexcept
+        : block(block), start(start), length(length) {}
+
+    static Block* newBlock(std::size_t size) {
+        void* memory = ::operator new(sizeof(Block) + size);
+        return new (memory) Block{{1}, size};
+    }
+
+    void retain() const noexcept {
+        if (block != nullptr) {
+            block->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void releaseBlock() noexcept {
+        if (block == nullptr) {
+            return;
+        }
+        // a sole owner cannot race with anybody: skip the read-modify-write
+        if (block->refs.load(std::memory_order_acquire) == 1 ||
+            block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            block->~Block();
+            ::operator delete(block);
+        }
+        block = nullptr;
+    }
+
+public:
+    SharedBytes() noexcept: block(nullptr), start(nullptr), length(0) {}
+
+    // copies `bytes` into a new buffer, the only copy a pipeline should make
+    explicit SharedBytes(std::string_view bytes): SharedBytes() {
+        if (!bytes.empty()) {
+            block = newBlock(bytes.size());
+            std::memcpy(block->bytes(), bytes.data(), bytes.size());
+            start = block->bytes();
+            length = bytes.size();
+        }
+    }
+
+    // a buffer of `size` bytes written once by fill(char*), e.g. straight from a read() call
+    template <typename Fill>
+    static SharedBytes build(std::size_t size, Fill fill) {
+        if (size == 0) {
+            return SharedBytes();
+        }
+        Block* block = newBlock(size);
+        try {
+            fill(block->bytes());
+        } catch (...) {
+            block->~Block();
+            ::operator delete(block);
+            throw;
+        }
+        return SharedBytes(block, block->bytes(), size);
+    }
+
+    SharedBytes(const SharedBytes& other) noexcept
+        : block(other.block), start(other.start), length(other.length) {
+        retain();
+    }
+
+    SharedBytes(SharedBytes&& other) noexcept
+        : block(other.block), start(other.start), length(other.length) {
+        other.block = nullptr;
+        other.start = nullptr;
+        other.length = 0;
+    }
+
+    ~SharedBytes() {
+        releaseBlock();
+    }
+
+    SharedBytes& operator=(const SharedBytes& other) noexcept {
+        if (this != &other) {
+            other.retain();
+            releaseBlock();
+            block = other.block;
+            start = other.start;
+            length = other.length;
+        }
+        return *this;
+    }
+
+    SharedBytes& operator=(SharedBytes&& other) noexcept {
+        if (this != &other) {
+            releaseBlock();
+            block = other.block;
+            start = other.start;
+            length = other.length;
+            other.block = nullptr;
+            other.start = nullptr;
+            other.length = 0;
+        }
+        return *this;
+    }
+
+    // [offset, offset + count) of this view, clamped like string_view::substr;
+    // the slice shares the buffer
+    SharedBytes slice(std::size_t offset, std::size_t count = std::string_view::npos) const& {
+        if (offset > length) {
+            throw std::out_of_range("SharedBytes::slice");
+        }
+        retain();
+        return SharedBytes(block, start + offset, count < length - offset ? count : length - offset);
+    }
+
+    // slicing a temporary hands its reference over, no count update at all
+    SharedBytes slice(std::size_t offset, std::size_t count = std::string_view::npos) && {
+        if (offset > length) {
+            throw std::out_of_range("SharedBytes::slice");
+        }
+        SharedBytes result(std::move(*this));
+        result.start += offset;
+        result.length = count < result.length - offset ? count : result.length - offset;
+        return result;
+    }
+
+    const char* data() const noexcept { return start; }
+    std::size_t size() const noexcept { return length; }
+    bool empty() const noexcept { return length == 0; }
+
+    char operator[](std::size_t i) const noexcept { return start[i]; }
+    const char* begin() const noexcept { return start; }
+    const char* end() const noexcept { return start + length; }
+
+    // the view is valid as long as this SharedBytes (or another one on the same buffer) lives
+    operator std::string_view() const noexcept { return {start, length}; }
+    std::string_view view() const noexcept { return {start, length}; }
+    std::string str() const { return std::string(start, length); }
+
+    // owners of the underlying buffer, 0 for an empty SharedBytes
+    std::size_t useCount() const noexcept {
+        return block == nullptr ? 0 : block->refs.load(std::memory_order_relaxed);
+    }
+
+    // bytes of the whole buffer this view keeps alive
+    std::size_t bufferSize() const noexcept { return block == nullptr ? 0 : block->size; }
+
+    friend bool operator == (const SharedBytes& a, std::string_view b) noexcept { return a.view() == b; }
+    friend bool operator != (const SharedBytes& a, std::string_view b) noexcept { return a.view() != b; }
+};
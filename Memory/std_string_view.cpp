@@ -1,15 +1,132 @@
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
+#include <string>
 #include <string_view>
+#include <thread>
+#include <vector>
+#include "shared_bytes.h"
 
 void printSubstring(std::string_view sv) {
     std::cout << sv << std::endl;
 }
 
+// a reader that only looks at the bytes takes a string_view, whoever owns them
+std::size_t checksum(std::string_view bytes) {
+    std::size_t sum = 0;
+    for (char c : bytes) {
+        sum = sum * 31 + static_cast<unsigned char>(c);
+    }
+    return sum;
+}
+
+// a payload of `records` fixed-size records
+std::string makePayload(int records, int record_size) {
+    std::string payload;
+    payload.reserve(static_cast<std::size_t>(records) * record_size);
+    for (int r = 0; r < records; ++r) {
+        std::string record = "record " + std::to_string(r) + " ";
+        record.resize(record_size, static_cast<char>('a' + r % 26));
+        payload += record;
+    }
+    return payload;
+}
+
+// every record of every payload goes to each of `consumers` stages, which keep what they get
+// until the payload is done; Bytes is std::string (one copy per record and stage) or SharedBytes
+template <typename Bytes>
+long long fanOut(const std::string& source, int payloads, int record_size, int consumers, std::size_t& sink) {
+    auto start = std::chrono::steady_clock::now();
+    for (int p = 0; p < payloads; ++p) {
+        Bytes payload{source};
+        std::vector<std::vector<Bytes>> inboxes(consumers);
+        for (std::size_t offset = 0; offset < payload.size(); offset += record_size) {
+            Bytes record = payload.substr(offset, record_size);
+            for (auto& inbox : inboxes) {
+                inbox.push_back(record);
+            }
+        }
+        for (auto& inbox : inboxes) {
+            sink += checksum(inbox.back());
+        }
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// substr() as spelled by each type
+struct CopiedBytes : std::string {
+    explicit CopiedBytes(std::string_view bytes): std::string(bytes) {}
+    CopiedBytes substr(std::size_t offset, std::size_t count) const {
+        return CopiedBytes(std::string_view(*this).substr(offset, count));
+    }
+};
+
+struct SlicedBytes : SharedBytes {
+    explicit SlicedBytes(std::string_view bytes): SharedBytes(bytes) {}
+    SlicedBytes(SharedBytes bytes): SharedBytes(std::move(bytes)) {}
+    SlicedBytes substr(std::size_t offset, std::size_t count) const {
+        return slice(offset, count);
+    }
+};
+
 int main(int argc, char* argv[]) {
-    
+
     std::string str = "Hello, world!";
-    std::string_view sv = str.substr(7, 5);
+    // str.substr() would return a temporary std::string and the view would dangle at the ';',
+    // so take the substring of a view on str instead
+    std::string_view sv = std::string_view(str).substr(7, 5);
 
     printSubstring(sv);
-    return 0;
-}
\ No newline at end of file
+
+    // A view that keeps its bytes alive: the slice outlives the buffer it was cut from
+    SharedBytes world;
+    {
+        SharedBytes greeting{str};
+        world = greeting.slice(7, 5);
+        std::cout << "owners while greeting lives: " << world.useCount() << std::endl;
+    }
+    printSubstring(world);
+    std::cout << "owners after: " << world.useCount() << ", buffer " << world.bufferSize() << " bytes" << std::endl;
+
+    const int records = argc > 1 ? std::atoi(argv[1]) : 4096;
+    const int record_size = argc > 2 ? std::atoi(argv[2]) : 256;
+    const int consumers = argc > 3 ? std::atoi(argv[3]) : 8;
+    const int payloads = argc > 4 ? std::atoi(argv[4]) : 50;
+    const std::string source = makePayload(records, record_size);
+
+    // Zero-copy fan-out across threads: each worker gets slices and the producer drops the payload
+    std::vector<std::size_t> sums(consumers, 0);
+    std::vector<std::thread> workers;
+    {
+        SharedBytes payload{source};
+        for (int c = 0; c < consumers; ++c) {
+            std::vector<SharedBytes> inbox;
+            for (std::size_t offset = c * record_size; offset < payload.size(); offset += consumers * record_size) {
+                inbox.push_back(payload.slice(offset, record_size));
+            }
+            workers.emplace_back([inbox = std::move(inbox), &sum = sums[c]] {
+                for (const SharedBytes& record : inbox) {
+                    sum += checksum(record);
+                }
+            });
+        }
+    }
+    std::size_t threaded = 0;
+    for (int c = 0; c < consumers; ++c) {
+        workers[c].join();
+        threaded += sums[c];
+    }
+    std::cout << "\n" << consumers << " workers read " << records << " records after the producer let go, checksum "
+              << threaded << std::endl;
+
+    std::size_t sink = 0;
+    long long copy_ms = fanOut<CopiedBytes>(source, payloads, record_size, consumers, sink);
+    long long shared_ms = fanOut<SlicedBytes>(source, payloads, record_size, consumers, sink);
+
+    std::cout << "\n" << payloads << " payloads of " << records << " x " << record_size << " byte records, each record to "
+              << consumers << " consumers" << std::endl;
+    std::cout << "  std::string copies:  " << copy_ms << " ms" << std::endl;
+    std::cout << "  SharedBytes slices:  " << shared_ms << " ms" << std::endl;
+
+    return sink == 0 ? 1 : 0;
+}
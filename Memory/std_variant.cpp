@@ -1,5 +1,11 @@
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
-#include<variant>
+#include <random>
+#include <string>
+#include <variant>
+#include <vector>
+#include "variant_vector.h"
 
 /*
 Unions in C++ were once commonly used to store values of different types in the same memory
@@ -14,6 +20,11 @@ the contained type. Unlike traditional unions, which rely on raw memory access a
 type errors, std::variant ensures that you can only access the current active type, thus
 avoiding undefined behavior.
 
+A std::variant is as large as its largest alternative plus the index, padded: with a std::string
+inside, every int in a std::vector<my_variant> takes 40 bytes. For long sequences of variants,
+VariantVector (variant_vector.h) stores one dense column per alternative instead and visits
+the values column by column, without a dispatch per element.
+
 reference: simplyfycpp.org
 */
 
@@ -26,6 +37,24 @@ void printVariant(const my_variant& v){
     v);
 }
 
+// what the bus does with every message: sum the numbers, count the text bytes
+struct Totals {
+    long long ints = 0;
+    double doubles = 0;
+    std::size_t text = 0;
+
+    void operator()(int value) { ints += value; }
+    void operator()(double value) { doubles += value; }
+    void operator()(const std::string& value) { text += value.size(); }
+};
+
+template <typename F>
+long long timeMs(F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
 int main(int argc, char* argv[]) {
 
     my_variant v1=10; //Holdsan int
@@ -35,5 +64,64 @@ int main(int argc, char* argv[]) {
     printVariant(v2); //Prints:3.14
     printVariant(v3); //Prints:Hello,world!
 
-    return 0;
-}
\ No newline at end of file
+    VariantVector<int, double, std::string> messages;
+    messages.push_back(v1);
+    messages.push_back(v2);
+    messages.push_back(v3);
+    messages.push_back(42);
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+        printVariant(messages.at(i)); //in insertion order
+    }
+    std::cout << messages.count<int>() << " ints, " << messages.count<double>() << " doubles, "
+              << messages.count<std::string>() << " strings" << std::endl;
+
+    const std::size_t count = argc > 1 ? std::atoll(argv[1]) : 10000000;
+    const int string_percent = argc > 2 ? std::atoi(argv[2]) : 10;
+
+    // the same random message stream in both layouts
+    std::mt19937 rng{42};
+    std::vector<my_variant> variants;
+    variants.reserve(count);
+    VariantVector<int, double, std::string> columns;
+    columns.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        int kind = static_cast<int>(rng() % 100);
+        if (kind < string_percent) {
+            variants.emplace_back(std::string("msg"));
+            columns.emplace_back<std::string>("msg");
+        } else if (kind < string_percent + (100 - string_percent) / 2) {
+            int value = static_cast<int>(rng() % 1000);
+            variants.emplace_back(value);
+            columns.push_back(value);
+        } else {
+            double value = (rng() % 1000) * 0.5;
+            variants.emplace_back(value);
+            columns.push_back(value);
+        }
+    }
+
+    Totals by_visit, by_index, by_type;
+    long long visit_ms = timeMs([&] {
+        for (const my_variant& v : variants) {
+            std::visit(by_visit, v);
+        }
+    });
+    long long index_ms = timeMs([&] {
+        for (std::size_t i = 0; i < columns.size(); ++i) {
+            columns.visitAt(i, by_index);
+        }
+    });
+    long long type_ms = timeMs([&] {
+        columns.forEachByType(by_type);
+    });
+
+    bool same = by_visit.ints == by_type.ints && by_visit.text == by_type.text && by_index.ints == by_type.ints;
+    std::cout << "\n" << count << " messages, " << string_percent << "% strings, the rest ints and doubles" << std::endl;
+    std::cout << "  std::vector<std::variant>: " << variants.capacity() * sizeof(my_variant) / (1 << 20) << " MB, "
+              << "std::visit per element " << visit_ms << " ms" << std::endl;
+    std::cout << "  VariantVector:             " << columns.memoryBytes() / (1 << 20) << " MB, "
+              << "visitAt in order " << index_ms << " ms, forEachByType " << type_ms << " ms" << std::endl;
+    std::cout << "  same totals: " << (same ? "yes" : "no") << std::endl;
+
+    return same ? 0 : 1;
+}
@@ -0,0 +1,324 @@
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+#include "memory_pool.h"
+
+// Thread-caching allocator (tcmalloc-style):
+// Small sizes are rounded up to one of kClassCount size classes. Every thread keeps its own
+// free list per class, so most allocations and frees touch no lock and no shared cache line.
+// Blocks move between a thread and the central free list of their class in batches:
+// - a thread whose list is empty takes a whole batch from the central list (one lock)
+// - a thread whose list grows past two batches gives one batch back (one lock)
+// The central lists get fresh blocks from a FixedPool per class. A block freed by another
+// thread than the one that allocated it simply joins the freeing thread's cache.
+// Sizes above kMaxSmallSize go straight to ::operator new.
+
+constexpr std::size_t kClassSizes[] = {
+    16, 32, 48, 64, 80, 96, 112, 128,
+    160, 192, 224, 256, 320, 384, 448, 512,
+    640, 768, 896, 1024, 1280, 1536, 1792, 2048,
+};
+constexpr int kClassCount = sizeof(kClassSizes) / sizeof(kClassSizes[0]);
+constexpr std::size_t kMaxSmallSize = kClassSizes[kClassCount - 1];
+constexpr std::size_t kClassAlignment = 16;
+
+// size class for every multiple of 16 up to kMaxSmallSize
+constexpr std::array<uint8_t, kMaxSmallSize / 16 + 1> makeClassTable() {
+    std::array<uint8_t, kMaxSmallSize / 16 + 1> table{};
+    int cls = 0;
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        while (kClassSizes[cls] < i * 16) {
+            cls++;
+        }
+        table[i] = static_cast<uint8_t>(cls);
+    }
+    return table;
+}
+
+constexpr auto kClassTable = makeClassTable();
+
+inline int sizeClass(std::size_t size) {
+    return kClassTable[(size + 15) / 16];
+}
+
+// blocks moved per transfer: about 8 KB worth, between 2 and 32 blocks
+constexpr int batchSize(int cls) {
+    std::size_t blocks = 8192 / kClassSizes[cls];
+    return blocks < 2 ? 2 : (blocks > 32 ? 32 : static_cast<int>(blocks));
+}
+
+struct CachedBlock {
+    CachedBlock* next;
+};
+
+class CentralFreeList {
+private:
+    std::mutex lock;
+    FixedPool pool;
+    CachedBlock* free_list;
+
+public:
+    explicit CentralFreeList(std::size_t block_size)
+        : pool(block_size, kClassAlignment, 256), free_list(nullptr) {}
+
+    // a chain of exactly n blocks
+    CachedBlock* removeBatch(int n) {
+        std::lock_guard<std::mutex> guard{lock};
+        CachedBlock* head = nullptr;
+        for (int i = 0; i < n; ++i) {
+            CachedBlock* block = free_list;
+            if (block != nullptr) {
+                free_list = block->next;
+            } else {
+                block = static_cast<CachedBlock*>(pool.allocate());
+            }
+            block->next = head;
+            head = block;
+        }
+        return head;
+    }
+
+    void insertBatch(CachedBlock* head, CachedBlock* tail) {
+        std::lock_guard<std::mutex> guard{lock};
+        tail->next = free_list;
+        free_list = head;
+    }
+};
+
+// The central lists are never destroyed: thread caches of threads that are still running
+// at exit (detached threads, the main thread's thread_locals) may hand blocks back late.
+inline CentralFreeList& centralList(int cls) {
+    static CentralFreeList* lists = [] {
+        auto* storage = static_cast<CentralFreeList*>(::operator new(sizeof(CentralFreeList) * kClassCount));
+        for (int i = 0; i < kClassCount; ++i) {
+            new (&storage[i]) CentralFreeList(kClassSizes[i]);
+        }
+        return storage;
+    }();
+    return lists[cls];
+}
+
+class ThreadCache {
+private:
+    struct FreeList {
+        CachedBlock* head = nullptr;
+        int length = 0;
+    };
+
+    FreeList lists[kClassCount];
+
+public:
+    ThreadCache() = default;
+    ThreadCache(const ThreadCache&) = delete;
+    ThreadCache& operator=(const ThreadCache&) = delete;
+
+    // everything still cached goes back when the thread exits
+    ~ThreadCache() {
+        for (int cls = 0; cls < kClassCount; ++cls) {
+            while (lists[cls].length > 0) {
+                releaseBatch(cls, lists[cls].length);
+            }
+        }
+    }
+
+    void* allocate(int cls) {
+        FreeList& list = lists[cls];
+        if (list.head == nullptr) {
+            list.head = centralList(cls).removeBatch(batchSize(cls));
+            list.length = batchSize(cls);
+        }
+        CachedBlock* block = list.head;
+        list.head = block->next;
+        list.length--;
+        return block;
+    }
+
+    void deallocate(void* p, int cls) {
+        FreeList& list = lists[cls];
+        CachedBlock* block = static_cast<CachedBlock*>(p);
+        block->next = list.head;
+        list.head = block;
+        list.length++;
+        if (list.length > 2 * batchSize(cls)) {
+            releaseBatch(cls, batchSize(cls));
+        }
+    }
+
+private:
+    void releaseBatch(int cls, int n) {
+        FreeList& list = lists[cls];
+        CachedBlock* head = list.head;
+        CachedBlock* tail = head;
+        for (int i = 1; i < n; ++i) {
+            tail = tail->next;
+        }
+        list.head = tail->next;
+        list.length -= n;
+        centralList(cls).insertBatch(head, tail);
+    }
+};
+
+class ThreadCachingPool {
+public:
+    static void* allocate(std::size_t size) {
+        if (size > kMaxSmallSize) {
+            return ::operator new(size);
+        }
+        return cache().allocate(sizeClass(size));
+    }
+
+    // size must be the one passed to allocate
+    static void deallocate(void* p, std::size_t size) {
+        if (size > kMaxSmallSize) {
+            ::operator delete(p);
+            return;
+        }
+        cache().deallocate(p, sizeClass(size));
+    }
+
+private:
+    static ThreadCache& cache() {
+        thread_local ThreadCache thread_cache;
+        return thread_cache;
+    }
+};
+
+// Standard allocator on top of ThreadCachingPool, usable from any number of threads.
+template <typename T>
+class ThreadCachingAllocator {
+public:
+    using value_type = T;
+
+    static_assert(alignof(T) <= kClassAlignment, "over-aligned types are not supported");
+
+    ThreadCachingAllocator() noexcept = default;
+
+    template <typename U>
+    ThreadCachingAllocator(const ThreadCachingAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(ThreadCachingPool::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        ThreadCachingPool::deallocate(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator == (const ThreadCachingAllocator<U>&) const noexcept { return true; }
+
+    template <typename U>
+    bool operator != (const ThreadCachingAllocator<U>&) const noexcept { return false; }
+};
+
+// the alternative without thread caches: one FixedPool per class behind a single mutex
+class LockedPools {
+private:
+    std::mutex lock;
+    std::vector<FixedPool*> pools;
+
+public:
+    LockedPools() {
+        for (int cls = 0; cls < kClassCount; ++cls) {
+            pools.push_back(new FixedPool(kClassSizes[cls], kClassAlignment, 256));
+        }
+    }
+
+    ~LockedPools() {
+        for (FixedPool* pool : pools) {
+            delete pool;
+        }
+    }
+
+    void* allocate(std::size_t size) {
+        std::lock_guard<std::mutex> guard{lock};
+        return pools[sizeClass(size)]->allocate();
+    }
+
+    void deallocate(void* p, std::size_t size) {
+        std::lock_guard<std::mutex> guard{lock};
+        pools[sizeClass(size)]->deallocate(p);
+    }
+};
+
+// every thread keeps `live` blocks of 16..512 bytes and replaces a random one `ops` times
+template <typename Alloc, typename Free>
+double benchmark(int threads, int live, int ops, Alloc alloc, Free release) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([=] {
+            std::minstd_rand rng(t + 1);
+            std::vector<std::pair<void*, std::size_t>> blocks(live);
+            for (auto& block : blocks) {
+                block.second = 16 + rng() % 497;
+                block.first = alloc(block.second);
+            }
+            for (int i = 0; i < ops; ++i) {
+                auto& block = blocks[rng() % live];
+                release(block.first, block.second);
+                block.second = 16 + rng() % 497;
+                block.first = alloc(block.second);
+                static_cast<char*>(block.first)[0] = 1;
+            }
+            for (auto& block : blocks) {
+                release(block.first, block.second);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(threads) * ops / seconds;
+}
+
+int main(int argc, char* argv[]) {
+    // maps built on two threads, torn down on a third: blocks flow between the caches
+    using CachedMap = std::map<int, int, std::less<int>, ThreadCachingAllocator<std::pair<const int, int>>>;
+    CachedMap evens, odds;
+    std::thread a([&evens] { for (int i = 0; i < 1000; i += 2) evens[i] = i; });
+    std::thread b([&odds] { for (int i = 1; i < 1000; i += 2) odds[i] = i; });
+    a.join();
+    b.join();
+    std::thread c([&evens, &odds] {
+        std::cout << "evens " << evens.size() << ", odds " << odds.size() << std::endl;
+        evens.clear();
+        odds.clear();
+    });
+    c.join();
+
+    const int max_threads = argc > 1 ? std::atoi(argv[1]) : 64;
+    const int ops = argc > 2 ? std::atoi(argv[2]) : 1000000;
+    const int live = argc > 3 ? std::atoi(argv[3]) : 1000;
+
+    std::cout << "\n" << ops << " random free + allocate per thread, " << live
+              << " live blocks of 16-512 bytes per thread (ops/s)" << std::endl;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        double malloc_ops = benchmark(threads, live, ops,
+                                      [](std::size_t size) { return std::malloc(size); },
+                                      [](void* p, std::size_t) { std::free(p); });
+        double cached_ops = benchmark(threads, live, ops,
+                                      [](std::size_t size) { return ThreadCachingPool::allocate(size); },
+                                      [](void* p, std::size_t size) { ThreadCachingPool::deallocate(p, size); });
+        LockedPools locked;
+        double locked_ops = benchmark(threads, live, ops,
+                                      [&locked](std::size_t size) { return locked.allocate(size); },
+                                      [&locked](void* p, std::size_t size) { locked.deallocate(p, size); });
+
+        std::cout << "  " << threads << " threads: malloc " << static_cast<long long>(malloc_ops)
+                  << ", ThreadCachingPool " << static_cast<long long>(cached_ops)
+                  << ", one locked pool " << static_cast<long long>(locked_ops) << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// Columnar storage for a sequence of std::variant<Ts...> values:
+// A std::vector<std::variant<int, double, std::string>> spends 40 bytes on every element
+// (the largest alternative, the index, padding) and std::visit dispatches on each one.
+// VariantVector instead keeps
+// - one dense std::vector per alternative, holding only the values of that type
+// - a tag per element (which column) and its slot in that column, to keep the order
+// so an int costs 1 + 4 + 4 bytes, and the batched visitors run one tight loop per column
+// with no dispatch inside it:
+// - forEachByType(f) calls f(value) for every value, grouped by type
+// - visitColumns(f) hands f each column as a whole (const std::vector<T>&)
+// visitAt(i, f) visits one element in order, like std::visit, when the order matters.
+// Append-only: elements can be read and modified in place but not erased one by one.
+
+namespace variant_vector_detail {
+
+// position of T in Ts..., a compile error when T is not one of them
+template <typename T, typename... Ts>
+struct TypeIndex;
+
+template <typename T, typename... Rest>
+struct TypeIndex<T, T, Rest...> : std::integral_constant<std::size_t, 0> {};
+
+template <typename T, typename U, typename... Rest>
+struct TypeIndex<T, U, Rest...> : std::integral_constant<std::size_t, 1 + TypeIndex<T, Rest...>::value> {};
+
+}
+
+template <typename... Ts>
+class VariantVector {
+public:
+    static_assert(sizeof...(Ts) > 0 && sizeof...(Ts) <= 255, "between 1 and 255 alternatives");
+
+    using variant_type = std::variant<Ts...>;
+
+    template <typename T>
+    static constexpr std::size_t indexOf = variant_vector_detail::TypeIndex<T, Ts...>::value;
+
+private:
+    std::vector<std::uint8_t> tags;
+    std::vector<std::uint32_t> slots;
+    std::tuple<std::vector<Ts>...> columns;
+
+    template <std::size_t I, typename F, typename R>
+    static R callAt(const VariantVector& self, std::uint32_t slot, F& f) {
+        return f(std::get<I>(self.columns)[slot]);
+    }
+
+    template <std::size_t I, typename F, typename R>
+    static R callAtMutable(VariantVector& self, std::uint32_t slot, F& f) {
+        return f(std::get<I>(self.columns)[slot]);
+    }
+
+    template <typename F, std::size_t... I>
+    decltype(auto) dispatch(std::size_t i, F& f, std::index_sequence<I...>) const {
+        using R = std::invoke_result_t<F&, const std::tuple_element_t<0, std::tuple<Ts...>>&>;
+        static_assert((std::is_same_v<R, std::invoke_result_t<F&, const Ts&>> && ...),
+                      "visitAt requires f to return the same type for every alternative");
+        static constexpr R (*table[])(const VariantVector&, std::uint32_t, F&) = {&callAt<I, F, R>...};
+        return table[tags[i]](*this, slots[i], f);
+    }
+
+    template <typename F, std::size_t... I>
+    decltype(auto) dispatch(std::size_t i, F& f, std::index_sequence<I...>) {
+        using R = std::invoke_result_t<F&, std::tuple_element_t<0, std::tuple<Ts...>>&>;
+        static_assert((std::is_same_v<R, std::invoke_result_t<F&, Ts&>> && ...),
+                      "visitAt requires f to return the same type for every alternative");
+        static constexpr R (*table[])(VariantVector&, std::uint32_t, F&) = {&callAtMutable<I, F, R>...};
+        return table[tags[i]](*this, slots[i], f);
+    }
+
+public:
+    std::size_t size() const { return tags.size(); }
+    bool empty() const { return tags.empty(); }
+
+    // capacity for n elements in the order arrays; columns grow on their own
+    void reserve(std::size_t n) {
+        tags.reserve(n);
+        slots.reserve(n);
+    }
+
+    void clear() {
+        tags.clear();
+        slots.clear();
+        std::apply([](auto&... column) { (column.clear(), ...); }, columns);
+    }
+
+    // appends a T built from args; T must be exactly one of the alternatives.
+    // If anything throws, the container is left as it was.
+    template <typename T, typename... Args>
+    T& emplace_back(Args&&... args) {
+        constexpr std::size_t index = indexOf<T>;
+        auto& column = std::get<index>(columns);
+        // the value first: if its constructor throws, no tag or slot points at it
+        column.emplace_back(std::forward<Args>(args)...);
+        try {
+            slots.push_back(static_cast<std::uint32_t>(column.size() - 1));
+            tags.push_back(static_cast<std::uint8_t>(index));
+        } catch (...) {
+            if (slots.size() > tags.size()) {
+                slots.pop_back();
+            }
+            column.pop_back();
+            throw;
+        }
+        return column.back();
+    }
+
+    template <typename T, typename = std::enable_if_t<(std::is_same_v<std::decay_t<T>, Ts> || ...)>>
+    void push_back(T&& value) {
+        emplace_back<std::decay_t<T>>(std::forward<T>(value));
+    }
+
+    void push_back(const variant_type& value) {
+        std::visit([this](const auto& alternative) {
+            emplace_back<std::decay_t<decltype(alternative)>>(alternative);
+        }, value);
+    }
+
+    // index of the alternative element i holds, as variant::index()
+    std::size_t index(std::size_t i) const { return tags[i]; }
+
+    template <typename T>
+    bool holds(std::size_t i) const { return tags[i] == indexOf<T>; }
+
+    // element i as a T; it must hold one (check with holds<T>)
+    template <typename T>
+    const T& get(std::size_t i) const { return std::get<indexOf<T>>(columns)[slots[i]]; }
+
+    template <typename T>
+    T& get(std::size_t i) { return std::get<indexOf<T>>(columns)[slots[i]]; }
+
+    // a copy of element i as a std::variant
+    variant_type at(std::size_t i) const {
+        return visitAt(i, [](const auto& value) { return variant_type(value); });
+    }
+
+    // f(element i) through a table of one function per alternative, like std::visit;
+    // f must return the same type for every alternative, checked at compile time as std::visit does
+    template <typename F>
+    decltype(auto) visitAt(std::size_t i, F&& f) const {
+        return dispatch(i, f, std::index_sequence_for<Ts...>{});
+    }
+
+    template <typename F>
+    decltype(auto) visitAt(std::size_t i, F&& f) {
+        return dispatch(i, f, std::index_sequence_for<Ts...>{});
+    }
+
+    // every value of type T, in insertion order
+    template <typename T>
+    const std::vector<T>& column() const { return std::get<indexOf<T>>(columns); }
+
+    template <typename T>
+    std::size_t count() const { return column<T>().size(); }
+
+    // f(value) for every value, all of the first alternative, then all of the second, ...
+    template <typename F>
+    void forEachByType(F&& f) const {
+        std::apply([&f](const auto&... column) {
+            auto each = [&f](const auto& values) {
+                for (const auto& value : values) {
+                    f(value);
+                }
+            };
+            (each(column), ...);
+        }, columns);
+    }
+
+    // f(column) once per alternative, with the whole const std::vector<T>&
+    template <typename F>
+    void visitColumns(F&& f) const {
+        std::apply([&f](const auto&... column) { (f(column), ...); }, columns);
+    }
+
+    // bytes held by the arrays themselves, not counting what the values own (string buffers)
+    std::size_t memoryBytes() const {
+        std::size_t bytes = tags.capacity() * sizeof(std::uint8_t) + slots.capacity() * sizeof(std::uint32_t);
+        std::apply([&bytes](const auto&... column) {
+            ((bytes += column.capacity() * sizeof(typename std::decay_t<decltype(column)>::value_type)), ...);
+        }, columns);
+        return bytes;
+    }
+};
@@ -0,0 +1,115 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "intrusive_ptr.h"
+
+// The count inside the object: IntrusivePtr<Node> is one pointer and makeIntrusive is one allocation.
+class Node : public RefCounted<Node> {
+public:
+    explicit Node(std::string name): name(std::move(name)) { std::cout << "Node " << this->name << " created" << std::endl; }
+    ~Node() { std::cout << "Node " << name << " destroyed" << std::endl; }
+
+    const std::string& getName() const { return name; }
+
+private:
+    std::string name;
+};
+
+// the payload of the benchmark, once per counting scheme
+struct Payload {
+    long value = 1;
+};
+
+struct AtomicPayload : Payload, RefCounted<AtomicPayload, AtomicRefCount> {};
+struct LocalPayload : Payload, RefCounted<LocalPayload, LocalRefCount> {};
+
+// passing by value: one copy and one release per call
+template <typename Ptr>
+__attribute__((noinline)) long consume(Ptr ptr) {
+    return ptr->value;
+}
+
+// `copies` pointers copied from one source, then released, `rounds` times; nanoseconds per copy + release
+template <typename Ptr>
+double copyLoop(const Ptr& source, int copies, int rounds, long& sink) {
+    std::vector<Ptr> held;
+    held.reserve(copies);
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < copies; ++i) {
+            held.push_back(source);
+        }
+        for (int i = 0; i < copies; ++i) {
+            sink += consume(held[i]);
+        }
+        held.clear();
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return ns / (2.0 * copies * rounds);
+}
+
+// nanoseconds to create and destroy one object
+template <typename Make>
+double createLoop(int count, Make make, long& sink) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        auto ptr = make();
+        sink += ptr->value;
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+}
+
+int main(int argc, char* argv[]) {
+
+    IntrusivePtr<Node> root = makeIntrusive<Node>("root");
+    WeakIntrusivePtr<Node> observer = root;
+    {
+        IntrusivePtr<Node> copy = root;
+        std::cout << "use count with a copy: " << root.useCount() << std::endl;
+    }
+    if (auto locked = observer.lock()) {
+        std::cout << "locked " << locked->getName() << ", use count " << locked.useCount() << std::endl;
+    }
+    root.reset();
+    std::cout << "after reset, observer expired: " << (observer.expired() ? "yes" : "no")
+              << ", lock gives " << (observer.lock() ? "an object" : "nullptr") << std::endl;
+
+    std::cout << "\nsizeof shared_ptr " << sizeof(std::shared_ptr<Payload>) << ", IntrusivePtr "
+              << sizeof(IntrusivePtr<AtomicPayload>) << " bytes" << std::endl;
+
+    const int copies = argc > 1 ? std::atoi(argv[1]) : 1000;
+    const int rounds = argc > 2 ? std::atoi(argv[2]) : 20000;
+    const int objects = argc > 3 ? std::atoi(argv[3]) : 5000000;
+
+    // libstdc++ skips the atomics in shared_ptr while a program has only ever run one thread;
+    // start one so every variant below pays what it would in a real server
+    std::thread([] {}).join();
+
+    long sink = 0;
+    auto shared = std::make_shared<Payload>();
+    auto atomic = makeIntrusive<AtomicPayload>();
+    auto local = makeIntrusive<LocalPayload>();
+    double shared_copy = copyLoop(shared, copies, rounds, sink);
+    double atomic_copy = copyLoop(atomic, copies, rounds, sink);
+    double local_copy = copyLoop(local, copies, rounds, sink);
+
+    std::cout << "\ncopy + release in a tight loop, " << copies << " copies x " << rounds << " rounds (ns each)" << std::endl;
+    std::cout << "  std::shared_ptr:               " << shared_copy << std::endl;
+    std::cout << "  IntrusivePtr, AtomicRefCount:  " << atomic_copy << std::endl;
+    std::cout << "  IntrusivePtr, LocalRefCount:   " << local_copy << std::endl;
+
+    double shared_new = createLoop(objects, [] { return std::shared_ptr<Payload>(new Payload()); }, sink);
+    double make_shared = createLoop(objects, [] { return std::make_shared<Payload>(); }, sink);
+    double intrusive_new = createLoop(objects, [] { return makeIntrusive<AtomicPayload>(); }, sink);
+
+    std::cout << "\ncreate + destroy, " << objects << " objects (ns each)" << std::endl;
+    std::cout << "  shared_ptr(new T), 2 allocations: " << shared_new << std::endl;
+    std::cout << "  make_shared, 1 allocation:        " << make_shared << std::endl;
+    std::cout << "  makeIntrusive, 1 allocation:      " << intrusive_new << std::endl;
+
+    return sink == 0 ? 1 : 0;
+}
@@ -0,0 +1,331 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+// Intrusive reference counting:
+// The count lives inside the object (derive from RefCounted<T>), so there is no control block
+// to allocate, and IntrusivePtr<T> is a single pointer. The Policy picks the counter:
+// - AtomicRefCount: std::atomic, for objects shared between threads (relaxed increment,
+//   acq_rel decrement, like std::shared_ptr)
+// - LocalRefCount: a plain integer, for objects that never leave one thread; a copy is
+//   then an ordinary increment the compiler can even fold away
+// The last owner of an object without weak references frees it without an atomic
+// read-modify-write, and makeIntrusive sets the first reference with a plain store.
+// Weak references go through a side table (WeakControl) that is only allocated when the
+// first WeakIntrusivePtr is made, so objects nobody observes pay one pointer for it.
+// The side table holds a pointer to the object and a mutex (a no-op for LocalRefCount):
+// lock() takes a strong reference under the mutex only if the count is not zero yet, and
+// the last release takes the same mutex to clear the pointer before deleting the object.
+
+struct AtomicRefCount {
+    class Counter {
+    public:
+        explicit Counter(std::uint32_t value) noexcept: value(value) {}
+
+        void increment() noexcept { value.fetch_add(1, std::memory_order_relaxed); }
+
+        // true when this was the last reference
+        bool decrement() noexcept { return value.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+
+        bool incrementIfNonZero() noexcept {
+            std::uint32_t current = value.load(std::memory_order_relaxed);
+            while (current != 0) {
+                if (value.compare_exchange_weak(current, current + 1, std::memory_order_acq_rel,
+                                                std::memory_order_relaxed)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::uint32_t load() const noexcept { return value.load(std::memory_order_relaxed); }
+
+        // the only reference: nobody else can change the count, so it needs no read-modify-write
+        bool isLastReference() const noexcept { return value.load(std::memory_order_acquire) == 1; }
+
+        // first reference to an object no other thread has seen yet
+        void initialize(std::uint32_t count) noexcept { value.store(count, std::memory_order_relaxed); }
+
+    private:
+        std::atomic<std::uint32_t> value;
+    };
+
+    template <typename T>
+    using Cell = std::atomic<T>;
+
+    using Mutex = std::mutex;
+};
+
+struct LocalRefCount {
+    class Counter {
+    public:
+        explicit Counter(std::uint32_t value) noexcept: value(value) {}
+
+        void increment() noexcept { ++value; }
+        bool decrement() noexcept { return --value == 0; }
+
+        bool incrementIfNonZero() noexcept {
+            if (value == 0) {
+                return false;
+            }
+            ++value;
+            return true;
+        }
+
+        std::uint32_t load() const noexcept { return value; }
+        bool isLastReference() const noexcept { return value == 1; }
+        void initialize(std::uint32_t count) noexcept { value = count; }
+
+    private:
+        std::uint32_t value;
+    };
+
+    // the subset of std::atomic<T> RefCounted uses, without the atomics
+    template <typename T>
+    class Cell {
+    public:
+        explicit Cell(T value) noexcept: value(value) {}
+
+        T load(std::memory_order = std::memory_order_seq_cst) const noexcept { return value; }
+
+        bool compare_exchange_strong(T& expected, T desired, std::memory_order, std::memory_order) noexcept {
+            if (value != expected) {
+                expected = value;
+                return false;
+            }
+            value = desired;
+            return true;
+        }
+
+    private:
+        T value;
+    };
+
+    struct Mutex {
+        void lock() noexcept {}
+        void unlock() noexcept {}
+    };
+};
+
+// side table for weak references to one T
+template <typename T, typename Policy>
+class WeakControl {
+public:
+    explicit WeakControl(T* object) noexcept: refs(1), object(object) {}
+
+    WeakControl(const WeakControl&) = delete;
+    WeakControl& operator=(const WeakControl&) = delete;
+
+    void addRef() noexcept { refs.increment(); }
+
+    void release() noexcept {
+        if (refs.decrement()) {
+            delete this;
+        }
+    }
+
+    // the object with one more strong reference, or nullptr once it is gone
+    T* lock() noexcept {
+        std::lock_guard<typename Policy::Mutex> guard{mutex};
+        if (object != nullptr && object->tryAddRef()) {
+            return object;
+        }
+        return nullptr;
+    }
+
+    bool expired() noexcept {
+        std::lock_guard<typename Policy::Mutex> guard{mutex};
+        return object == nullptr || object->useCount() == 0;
+    }
+
+    // called by the object's last release, before it is deleted
+    void expire() noexcept {
+        {
+            std::lock_guard<typename Policy::Mutex> guard{mutex};
+            object = nullptr;
+        }
+        release();
+    }
+
+private:
+    typename Policy::Counter refs;      // weak pointers, plus one while the object lives
+    typename Policy::Mutex mutex;
+    T* object;
+};
+
+// Base class for objects managed by IntrusivePtr<Derived>. The count starts at zero;
+// the first IntrusivePtr takes the first reference. Classes that derive from Derived
+// need a virtual destructor, the object is deleted as a Derived.
+template <typename Derived, typename Policy = AtomicRefCount>
+class RefCounted {
+public:
+    using Control = WeakControl<Derived, Policy>;
+
+    void addRef() const noexcept { refs.increment(); }
+
+    void release() const noexcept {
+        // without a side table nobody can take a new reference behind the last owner's back;
+        // the count is read first, its acquire makes a side table made by an earlier owner visible
+        if ((refs.isLastReference() && weak.load(std::memory_order_relaxed) == nullptr) || refs.decrement()) {
+            destroy();
+        }
+    }
+
+    // the first reference of a new object, before it is shared (see makeIntrusive)
+    void adoptFirstRef() const noexcept { refs.initialize(1); }
+
+    // a new strong reference, unless the object is already being destroyed
+    bool tryAddRef() const noexcept { return refs.incrementIfNonZero(); }
+
+    std::uint32_t useCount() const noexcept { return refs.load(); }
+
+    // the side table, made on first use
+    Control* weakControl() const {
+        Control* control = weak.load(std::memory_order_acquire);
+        if (control == nullptr) {
+            Control* fresh = new Control(static_cast<Derived*>(const_cast<RefCounted*>(this)));
+            if (weak.compare_exchange_strong(control, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                control = fresh;
+            } else {
+                delete fresh;
+            }
+        }
+        return control;
+    }
+
+protected:
+    RefCounted() noexcept: refs(0), weak(nullptr) {}
+
+    // a copy is a new object: it starts with its own count and no observers
+    RefCounted(const RefCounted&) noexcept: refs(0), weak(nullptr) {}
+    RefCounted& operator=(const RefCounted&) noexcept { return *this; }
+
+    ~RefCounted() = default;
+
+private:
+    void destroy() const noexcept {
+        Control* control = weak.load(std::memory_order_acquire);
+        if (control != nullptr) {
+            control->expire();
+        }
+        delete static_cast<const Derived*>(this);
+    }
+
+    mutable typename Policy::Counter refs;
+    mutable typename Policy::template Cell<Control*> weak;
+};
+
+template <typename T>
+class IntrusivePtr {
+public:
+    IntrusivePtr() noexcept: ptr(nullptr) {}
+
+    // takes a new reference on p; add_ref = false adopts one the caller already holds
+    explicit IntrusivePtr(T* p, bool add_ref = true) noexcept: ptr(p) {
+        if (ptr != nullptr && add_ref) {
+            ptr->addRef();
+        }
+    }
+
+    IntrusivePtr(const IntrusivePtr& other) noexcept: ptr(other.ptr) {
+        if (ptr != nullptr) {
+            ptr->addRef();
+        }
+    }
+
+    IntrusivePtr(IntrusivePtr&& other) noexcept: ptr(other.ptr) {
+        other.ptr = nullptr;
+    }
+
+    ~IntrusivePtr() {
+        if (ptr != nullptr) {
+            ptr->release();
+        }
+    }
+
+    IntrusivePtr& operator=(const IntrusivePtr& other) noexcept {
+        IntrusivePtr(other).swap(*this);
+        return *this;
+    }
+
+    IntrusivePtr& operator=(IntrusivePtr&& other) noexcept {
+        IntrusivePtr(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    void reset() noexcept { IntrusivePtr().swap(*this); }
+    void swap(IntrusivePtr& other) noexcept { std::swap(ptr, other.ptr); }
+
+    T* get() const noexcept { return ptr; }
+    T& operator*() const noexcept { return *ptr; }
+    T* operator->() const noexcept { return ptr; }
+    explicit operator bool() const noexcept { return ptr != nullptr; }
+
+    std::uint32_t useCount() const noexcept { return ptr == nullptr ? 0 : ptr->useCount(); }
+
+    bool operator == (const IntrusivePtr& other) const noexcept { return ptr == other.ptr; }
+    bool operator != (const IntrusivePtr& other) const noexcept { return ptr != other.ptr; }
+
+private:
+    T* ptr;
+};
+
+template <typename T, typename... Args>
+IntrusivePtr<T> makeIntrusive(Args&&... args) {
+    T* object = new T(std::forward<Args>(args)...);
+    object->adoptFirstRef();
+    return IntrusivePtr<T>(object, false);
+}
+
+// Observes a T without keeping it alive; lock() gives an IntrusivePtr while it still exists.
+template <typename T>
+class WeakIntrusivePtr {
+public:
+    using Control = typename T::Control;
+
+    WeakIntrusivePtr() noexcept: control(nullptr) {}
+
+    WeakIntrusivePtr(const IntrusivePtr<T>& strong): control(nullptr) {
+        if (strong) {
+            control = strong->weakControl();
+            control->addRef();
+        }
+    }
+
+    WeakIntrusivePtr(const WeakIntrusivePtr& other) noexcept: control(other.control) {
+        if (control != nullptr) {
+            control->addRef();
+        }
+    }
+
+    WeakIntrusivePtr(WeakIntrusivePtr&& other) noexcept: control(other.control) {
+        other.control = nullptr;
+    }
+
+    ~WeakIntrusivePtr() {
+        if (control != nullptr) {
+            control->release();
+        }
+    }
+
+    WeakIntrusivePtr& operator=(WeakIntrusivePtr other) noexcept {
+        std::swap(control, other.control);
+        return *this;
+    }
+
+    IntrusivePtr<T> lock() const noexcept {
+        if (control == nullptr) {
+            return IntrusivePtr<T>();
+        }
+        // lock() already took the reference, the IntrusivePtr adopts it
+        return IntrusivePtr<T>(static_cast<T*>(control->lock()), false);
+    }
+
+    bool expired() const noexcept { return control == nullptr || control->expired(); }
+
+private:
+    Control* control;
+};
@@ -1,21 +1,149 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 #include <memory_resource>
 
-// A custom resource that spies on its upstream allocator
+#if __has_include(<execinfo.h>)
+#include <execinfo.h>
+#define SPY_HAVE_BACKTRACE 1
+#else
+#define SPY_HAVE_BACKTRACE 0
+#endif
+
+// A custom resource that spies on its upstream allocator and profiles what goes through it:
+// - allocations, deallocations and bytes per power-of-two size bucket
+// - bytes currently in use and the high-water mark
+// - optionally, one in every `sample_every` allocations records its call stack, so the
+//   report can show which code (which container) allocates the most
+// The counters are relaxed atomics, one bucket per cache line, so the spy can sit under a
+// resource shared by many threads; only the sampled allocations take a lock, for one hash
+// lookup of their stack. The table holds at most kMaxCallSites stacks, samples from
+// stacks seen after it filled up are only counted as dropped.
 class SpyResource : public std::pmr::memory_resource {
 public:
-    SpyResource(std::pmr::memory_resource* upstream) : upstream_resource(upstream) {}
+    // bucket b holds sizes in (2^(b-1), 2^b], the last one everything larger
+    static constexpr int kBuckets = 24;
+    static constexpr int kStackDepth = 8;
+    static constexpr std::size_t kMaxCallSites = 4096;
+
+    explicit SpyResource(std::pmr::memory_resource* upstream, unsigned sample_every = 0)
+        : upstream_resource(upstream), sample_every(sample_every) {}
+
+    std::size_t bytesInUse() const {
+        return in_use.load(std::memory_order_relaxed);
+    }
+
+    std::size_t highWaterMark() const {
+        return high_water.load(std::memory_order_relaxed);
+    }
+
+    void report(std::ostream& out) const {
+        uint64_t total_allocations = 0;
+        uint64_t total_bytes = 0;
+        out << "  size bucket      allocs    deallocs       bytes" << std::endl;
+        for (int b = 0; b < kBuckets; ++b) {
+            uint64_t allocations = buckets[b].allocations.load(std::memory_order_relaxed);
+            if (allocations == 0) {
+                continue;
+            }
+            uint64_t bytes = buckets[b].bytes.load(std::memory_order_relaxed);
+            total_allocations += allocations;
+            total_bytes += bytes;
+
+            std::string range = b == kBuckets - 1 ? "> " + std::to_string(std::size_t{1} << (b - 1))
+                                                  : "<= " + std::to_string(std::size_t{1} << b);
+            out << "  " << std::left << std::setw(12) << range << std::right
+                << std::setw(10) << allocations
+                << std::setw(12) << buckets[b].deallocations.load(std::memory_order_relaxed)
+                << std::setw(12) << bytes << std::endl;
+        }
+        out << "  total " << total_allocations << " allocations, " << total_bytes << " bytes, in use "
+            << bytesInUse() << ", high-water mark " << highWaterMark() << std::endl;
+
+        std::vector<std::pair<CallStack, SiteCounts>> sites;
+        SiteCounts dropped;
+        {
+            std::lock_guard<std::mutex> guard{sites_lock};
+            sites.assign(call_sites.begin(), call_sites.end());
+            dropped = dropped_samples;
+        }
+        std::size_t shown = std::min<std::size_t>(sites.size(), 5);
+        std::partial_sort(sites.begin(), sites.begin() + shown, sites.end(),
+                          [](const auto& a, const auto& b) { return a.second.bytes > b.second.bytes; });
+        for (std::size_t i = 0; i < shown; ++i) {
+            out << "  call site #" << i + 1 << ": " << sites[i].second.samples << " samples, "
+                << sites[i].second.bytes << " bytes" << std::endl;
+            printStack(out, sites[i].first);
+        }
+        if (dropped.samples != 0) {
+            out << "  " << dropped.samples << " samples (" << dropped.bytes << " bytes) from call sites past the first "
+                << kMaxCallSites << std::endl;
+        }
+    }
 
 private:
+    struct alignas(64) Bucket {
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> deallocations{0};
+        std::atomic<uint64_t> bytes{0};
+    };
+
+    struct CallStack {
+        std::array<void*, kStackDepth> frames{};
+        int depth = 0;
+
+        bool operator == (const CallStack& other) const {
+            return depth == other.depth && frames == other.frames;
+        }
+    };
+
+    struct CallStackHash {
+        std::size_t operator()(const CallStack& stack) const {
+            uint64_t h = 14695981039346656037ull;
+            for (int i = 0; i < stack.depth; ++i) {
+                h = (h ^ reinterpret_cast<uintptr_t>(stack.frames[i])) * 1099511628211ull;
+            }
+            return static_cast<std::size_t>(h ^ (h >> 32));
+        }
+    };
+
+    struct SiteCounts {
+        uint64_t samples = 0;
+        uint64_t bytes = 0;
+    };
+
     // This gets called when our resource needs to allocate memory
     void* do_allocate(size_t bytes, size_t alignment) override {
-        std::cout << "--> Spy: Allocating " << bytes << " bytes from upstream! <--" << std::endl;
-        return upstream_resource->allocate(bytes, alignment);
+        void* p = upstream_resource->allocate(bytes, alignment);
+
+        Bucket& bucket = buckets[bucketOf(bytes)];
+        bucket.allocations.fetch_add(1, std::memory_order_relaxed);
+        bucket.bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+        std::size_t now = in_use.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        std::size_t peak = high_water.load(std::memory_order_relaxed);
+        while (now > peak && !high_water.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+        }
+
+        if (sample_every != 0 && allocation_count.fetch_add(1, std::memory_order_relaxed) % sample_every == 0) {
+            sample(bytes);
+        }
+        return p;
     }
 
     void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        buckets[bucketOf(bytes)].deallocations.fetch_add(1, std::memory_order_relaxed);
+        in_use.fetch_sub(bytes, std::memory_order_relaxed);
         upstream_resource->deallocate(p, bytes, alignment);
     }
 
@@ -23,7 +151,61 @@ private:
         return this == &other;
     }
 
+    static int bucketOf(std::size_t bytes) {
+        int b = 0;
+        while (b < kBuckets - 1 && (std::size_t{1} << b) < bytes) {
+            b++;
+        }
+        return b;
+    }
+
+    void sample(std::size_t bytes) {
+        CallStack site;
+#if SPY_HAVE_BACKTRACE
+        // skip sample() and do_allocate()
+        void* frames[kStackDepth + 2];
+        int depth = backtrace(frames, kStackDepth + 2) - 2;
+        for (int i = 0; i < depth; ++i) {
+            site.frames[i] = frames[i + 2];
+        }
+        site.depth = depth < 0 ? 0 : depth;
+#else
+        site.frames[0] = __builtin_return_address(0);
+        site.depth = 1;
+#endif
+
+        std::lock_guard<std::mutex> guard{sites_lock};
+        auto known = call_sites.find(site);
+        SiteCounts& counts = known != call_sites.end() ? known->second
+                           : call_sites.size() < kMaxCallSites ? call_sites[site]
+                           : dropped_samples;
+        counts.samples++;
+        counts.bytes += bytes;
+    }
+
+    static void printStack(std::ostream& out, const CallStack& site) {
+#if SPY_HAVE_BACKTRACE
+        char** symbols = backtrace_symbols(site.frames.data(), site.depth);
+        for (int i = 0; i < site.depth; ++i) {
+            out << "      " << (symbols != nullptr ? symbols[i] : "?") << std::endl;
+        }
+        std::free(symbols);
+#else
+        for (int i = 0; i < site.depth; ++i) {
+            out << "      " << site.frames[i] << std::endl;
+        }
+#endif
+    }
+
     std::pmr::memory_resource* upstream_resource;
+    unsigned sample_every;
+    Bucket buckets[kBuckets];
+    std::atomic<std::size_t> in_use{0};
+    std::atomic<std::size_t> high_water{0};
+    std::atomic<uint64_t> allocation_count{0};
+    mutable std::mutex sites_lock;
+    std::unordered_map<CallStack, SiteCounts, CallStackHash> call_sites;
+    SiteCounts dropped_samples;
 };
 
 int main() {
@@ -52,15 +234,29 @@ int main() {
 
     std::pmr::vector<std::shared_ptr<int>> vec{&pool_resource};
 
-    std::cout << "Starting to fill the vector. First 64 elements should be silent..." << std::endl;
+    std::cout << "Starting to fill the vector. The first allocations come from the 1 KB buffer..." << std::endl;
 
     // This loop will trigger the fallback
     for (int i = 0; i < 128; i++) {
         if (i == 64) {
-            std::cout << "\nBuffer is likely full. The next allocation should trigger the spy...\n" << std::endl;
+            std::cout << "At 64 elements the spy has seen " << spy.bytesInUse() << " bytes" << std::endl;
         }
         vec.emplace_back(std::make_shared<int>(i));
     }
 
     std::cout << "\nVector successfully holds " << vec.size() << " elements." << std::endl;
+    spy.report(std::cout);
+
+    // Containers straight on a sampling spy: every 16th allocation records its call stack
+    SpyResource profiler{std::pmr::new_delete_resource(), 16};
+    {
+        std::pmr::map<int, std::pmr::string> names{&profiler};
+        std::pmr::vector<int> ids{&profiler};
+        for (int i = 0; i < 10000; i++) {
+            names.emplace(i, "a name long enough to leave the small string buffer");
+            ids.push_back(i);
+        }
+    }
+    std::cout << "\nmap<int, string> + vector<int>, 10000 entries:" << std::endl;
+    profiler.report(std::cout);
 }
\ No newline at end of file
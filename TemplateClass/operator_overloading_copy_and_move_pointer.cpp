@@ -1,7 +1,17 @@
+#include <chrono>
+#include <deque>
 #include <iostream>
+#include <string>
+#include <string_view>
 #include <string.h>
+#include <unordered_set>
+#include <vector>
 
-class Person {
+// constructors and assignments print what they do; the benchmark switches this off
+bool trace = true;
+
+// The original Person: every object owns a new char[] for its name, even "Bob".
+class HeapPerson {
 private:
     // variables
     int id;
@@ -10,50 +20,50 @@ private:
 public:
 
     // constructors
-    Person();
-    Person(int id, const char* name);
-    Person(const Person& person);
-    Person(Person&& person) noexcept;
+    HeapPerson();
+    HeapPerson(int id, const char* name);
+    HeapPerson(const HeapPerson& person);
+    HeapPerson(HeapPerson&& person) noexcept;
 
     // destructor
-    ~Person();
+    ~HeapPerson();
 
     // operator overloadings
-    Person& operator=(const Person& person);
-    Person& operator=(Person&&) noexcept;
+    HeapPerson& operator=(const HeapPerson& person);
+    HeapPerson& operator=(HeapPerson&&) noexcept;
 };
 
 // constructors implementation
-Person::Person(): id{0}, name{nullptr} {}
+HeapPerson::HeapPerson(): id{0}, name{nullptr} {}
 
-Person::Person(int id, const char* name) {
+HeapPerson::HeapPerson(int id, const char* name) {
     this->id = id;
 
     this->name = new char[strlen(name)+1];
     memcpy(this->name, name, sizeof(*name)*strlen(name)+1);
 
-    printf("Overloading: Person(%d, %s) created!\n", this->id, this->name);
+    if (trace) printf("Overloading: HeapPerson(%d, %s) created!\n", this->id, this->name);
 }
 
-Person::Person(const Person& person): Person(person.id, person.name) {
-    printf("Copy: Person(%d, %s) created!\n", this->id, this->name);
+HeapPerson::HeapPerson(const HeapPerson& person): HeapPerson(person.id, person.name) {
+    if (trace) printf("Copy: HeapPerson(%d, %s) created!\n", this->id, this->name);
 }
 
-Person::Person(Person&& person) noexcept {
+HeapPerson::HeapPerson(HeapPerson&& person) noexcept {
     this->id = person.id;
 
     this->name = person.name;
     person.name = nullptr;
 
-    printf("Move: Person(%d, %s) created!\n", this->id, this->name);
+    if (trace) printf("Move: HeapPerson(%d, %s) created!\n", this->id, this->name);
 }
 
-Person::~Person() {
+HeapPerson::~HeapPerson() {
     delete [] this->name;
     this->name = nullptr;
 }
 
-Person& Person::operator=(const Person& person) {
+HeapPerson& HeapPerson::operator=(const HeapPerson& person) {
     if (this == &person) {
         return *this;
     } else {
@@ -65,13 +75,13 @@ Person& Person::operator=(const Person& person) {
         this->name = new char[strlen(person.name)+1];
         memcpy(this->name, person.name, sizeof(*person.name)*strlen(person.name)+1);
 
-        printf("New Data: Person(%d, %s) copied!\n", this->id, this->name);
+        if (trace) printf("New Data: HeapPerson(%d, %s) copied!\n", this->id, this->name);
 
         return *this;
     }
 }
 
-Person& Person::operator=(Person&& person) noexcept {
+HeapPerson& HeapPerson::operator=(HeapPerson&& person) noexcept {
     if (this == &person) {
         return *this;
     } else {
@@ -81,7 +91,265 @@ Person& Person::operator=(Person&& person) noexcept {
         this->name = person.name;
         person.name = nullptr;
 
-        printf("New Data: Person(%d, %s) moved!\n", this->id, this->name);
+        if (trace) printf("New Data: HeapPerson(%d, %s) moved!\n", this->id, this->name);
+
+        return *this;
+    }
+}
+
+// Interned names: each distinct string is stored once and lives until the program ends,
+// so a name that points into the table is copied as a bare pointer. Not thread-safe.
+class NameTable {
+private:
+    std::deque<std::string> storage;    // a deque never moves its strings
+    std::unordered_set<std::string_view> names;
+
+public:
+    std::string_view intern(std::string_view name) {
+        auto found = names.find(name);
+        if (found != names.end()) {
+            return *found;
+        }
+        storage.emplace_back(name);
+        return *names.insert(storage.back()).first;
+    }
+
+    std::size_t size() const { return names.size(); }
+};
+
+NameTable& nameTable() {
+    static NameTable table;
+    return table;
+}
+
+// a name that is already in the NameTable
+struct InternedName {
+    std::string_view name;
+};
+
+InternedName intern(std::string_view name) {
+    return {nameTable().intern(name)};
+}
+
+// Small-buffer name:
+// Up to kInlineSize characters are stored inside the object, with no allocation at all;
+// longer names go to the heap, or point into the NameTable when they were interned.
+// The last byte of the buffer tells which: kInlineSize - length for an inline name (so a
+// name of exactly kInlineSize characters ends in its own terminator), kHeap or kInterned
+// for an external one, whose pointer and length are kept at the start of the buffer.
+class PersonName {
+public:
+    static constexpr std::size_t kInlineSize = 23;
+
+private:
+    static constexpr unsigned char kHeap = 0x80;
+    static constexpr unsigned char kInterned = 0x81;
+
+    struct External {
+        const char* data;
+        std::size_t size;
+    };
+
+    char buffer[kInlineSize + 1];
+
+    unsigned char tag() const { return static_cast<unsigned char>(buffer[kInlineSize]); }
+    External external() const;
+    void setExternal(const char* data, std::size_t size, unsigned char tag);
+    void assign(std::string_view name);
+    void clear();
+
+public:
+
+    // constructors
+    PersonName();
+    explicit PersonName(std::string_view name);
+    explicit PersonName(InternedName name);
+    PersonName(const PersonName& other);
+    PersonName(PersonName&& other) noexcept;
+
+    // destructor
+    ~PersonName();
+
+    // operator overloadings
+    PersonName& operator=(const PersonName& other);
+    PersonName& operator=(PersonName&& other) noexcept;
+
+    const char* c_str() const;
+    std::size_t size() const;
+    bool isInline() const { return tag() <= kInlineSize; }
+    bool isInterned() const { return tag() == kInterned; }
+};
+
+PersonName::External PersonName::external() const {
+    External value;
+    memcpy(&value, buffer, sizeof(value));
+    return value;
+}
+
+void PersonName::setExternal(const char* data, std::size_t size, unsigned char tag) {
+    External value{data, size};
+    memcpy(buffer, &value, sizeof(value));
+    buffer[kInlineSize] = static_cast<char>(tag);
+}
+
+void PersonName::assign(std::string_view name) {
+    if (name.size() <= kInlineSize) {
+        memcpy(buffer, name.data(), name.size());
+        buffer[name.size()] = '\0';
+        buffer[kInlineSize] = static_cast<char>(kInlineSize - name.size());
+    } else {
+        char* data = new char[name.size()+1];
+        memcpy(data, name.data(), name.size());
+        data[name.size()] = '\0';
+        setExternal(data, name.size(), kHeap);
+    }
+}
+
+// frees a heap name and leaves an empty inline one
+void PersonName::clear() {
+    if (tag() == kHeap) {
+        delete [] external().data;
+    }
+    buffer[0] = '\0';
+    buffer[kInlineSize] = static_cast<char>(kInlineSize);
+}
+
+PersonName::PersonName() {
+    buffer[0] = '\0';
+    buffer[kInlineSize] = static_cast<char>(kInlineSize);
+}
+
+PersonName::PersonName(std::string_view name) {
+    assign(name);
+}
+
+PersonName::PersonName(InternedName name) {
+    setExternal(name.name.data(), name.name.size(), kInterned);
+}
+
+PersonName::PersonName(const PersonName& other) {
+    if (other.tag() == kHeap) {
+        assign({other.c_str(), other.size()});
+    } else {
+        // inline characters or the interned pointer, one fixed-size copy either way
+        memcpy(buffer, other.buffer, sizeof(buffer));
+    }
+}
+
+PersonName::PersonName(PersonName&& other) noexcept {
+    memcpy(buffer, other.buffer, sizeof(buffer));
+    if (other.tag() == kHeap) {
+        // the heap array changed owner, other must not free it
+        other.buffer[0] = '\0';
+        other.buffer[kInlineSize] = static_cast<char>(kInlineSize);
+    }
+}
+
+PersonName::~PersonName() {
+    if (tag() == kHeap) {
+        delete [] external().data;
+    }
+}
+
+PersonName& PersonName::operator=(const PersonName& other) {
+    if (this != &other) {
+        clear();
+        if (other.tag() == kHeap) {
+            assign({other.c_str(), other.size()});
+        } else {
+            memcpy(buffer, other.buffer, sizeof(buffer));
+        }
+    }
+    return *this;
+}
+
+PersonName& PersonName::operator=(PersonName&& other) noexcept {
+    if (this != &other) {
+        clear();
+        memcpy(buffer, other.buffer, sizeof(buffer));
+        if (other.tag() == kHeap) {
+            other.buffer[0] = '\0';
+            other.buffer[kInlineSize] = static_cast<char>(kInlineSize);
+        }
+    }
+    return *this;
+}
+
+const char* PersonName::c_str() const {
+    return isInline() ? buffer : external().data;
+}
+
+std::size_t PersonName::size() const {
+    return isInline() ? kInlineSize - tag() : external().size;
+}
+
+// Person with the name stored in a PersonName: no allocation for names of up to 23
+// characters and none for interned ones, moves and copies are a fixed-size memcpy.
+class Person {
+private:
+    // variables
+    int id;
+    PersonName name;
+
+public:
+
+    // constructors
+    Person();
+    Person(int id, const char* name);
+    Person(int id, InternedName name);
+    Person(const Person& person);
+    Person(Person&& person) noexcept;
+
+    // destructor
+    ~Person() = default;
+
+    // operator overloadings
+    Person& operator=(const Person& person);
+    Person& operator=(Person&&) noexcept;
+
+    const PersonName& getName() const { return this->name; }
+};
+
+// constructors implementation
+Person::Person(): id{0} {}
+
+Person::Person(int id, const char* name): id{id}, name{std::string_view{name}} {
+    if (trace) printf("Overloading: Person(%d, %s) created!\n", this->id, this->name.c_str());
+}
+
+Person::Person(int id, InternedName name): id{id}, name{name} {
+    if (trace) printf("Interned: Person(%d, %s) created!\n", this->id, this->name.c_str());
+}
+
+Person::Person(const Person& person): id{person.id}, name{person.name} {
+    if (trace) printf("Copy: Person(%d, %s) created!\n", this->id, this->name.c_str());
+}
+
+Person::Person(Person&& person) noexcept: id{person.id}, name{std::move(person.name)} {
+    if (trace) printf("Move: Person(%d, %s) created!\n", this->id, this->name.c_str());
+}
+
+Person& Person::operator=(const Person& person) {
+    if (this == &person) {
+        return *this;
+    } else {
+        this->id = person.id;
+        this->name = person.name;
+
+        if (trace) printf("New Data: Person(%d, %s) copied!\n", this->id, this->name.c_str());
+
+        return *this;
+    }
+}
+
+Person& Person::operator=(Person&& person) noexcept {
+    if (this == &person) {
+        return *this;
+    } else {
+        this->id = person.id;
+        this->name = std::move(person.name);
+
+        if (trace) printf("New Data: Person(%d, %s) moved!\n", this->id, this->name.c_str());
 
         return *this;
     }
@@ -95,14 +363,64 @@ char* createString(const char* str) {
     return newStr;
 }
 
+struct Timings {
+    double construct;
+    double copy;
+    double move;
+    double destroy;
+};
+
+// nanoseconds per object to construct `count` records, copy them, move them and destroy them all
+template <typename P, typename Construct>
+Timings benchmark(int count, Construct construct) {
+    using Clock = std::chrono::steady_clock;
+    auto perObject = [count](Clock::time_point start) {
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+    };
+    Timings timings;
+
+    auto start = Clock::now();
+    std::vector<P> people;
+    people.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        construct(people, i);
+    }
+    timings.construct = perObject(start);
+
+    start = Clock::now();
+    std::vector<P> copies(people);
+    timings.copy = perObject(start);
+
+    start = Clock::now();
+    std::vector<P> moved;
+    moved.reserve(count);
+    for (P& person : people) {
+        moved.push_back(std::move(person));
+    }
+    timings.move = perObject(start);
+
+    start = Clock::now();
+    people = std::vector<P>();
+    copies = std::vector<P>();
+    moved = std::vector<P>();
+    timings.destroy = perObject(start);
+
+    return timings;
+}
+
+void printTimings(const char* label, Timings timings) {
+    printf("  %-26s construct %6.1f  copy %6.1f  move %6.1f  destroy %6.1f\n",
+           label, timings.construct, timings.copy, timings.move, timings.destroy);
+}
+
 int main(int argc, char* argv[]) {
-    
+
     char* p1_name = createString("Person 1");
     Person p1 {1, p1_name};
 
     char* p2_name = createString("Person 2");
     Person p2 {2, p2_name};
-    
+
     Person p3 = std::move(Person{3, "Person 3"});
 
     // copy assignment operator
@@ -113,6 +431,39 @@ int main(int argc, char* argv[]) {
 
     delete [] p1_name;
     delete [] p2_name;
-    
+
+    // a name too long for the inline buffer, once on the heap and once interned
+    Person p4 {4, "Person 4 With A Rather Long Family Name"};
+    Person p5 {5, intern("Person 4 With A Rather Long Family Name")};
+    Person p6 = p5;
+    printf("p1 inline: %d, p4 inline: %d, p6 interned: %d\n",
+           p1.getName().isInline(), p4.getName().isInline(), p6.getName().isInterned());
+    printf("sizeof(HeapPerson) %zu + name on the heap, sizeof(Person) %zu\n", sizeof(HeapPerson), sizeof(Person));
+
+    const int count = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const int distinct = argc > 2 ? std::atoi(argv[2]) : 1000;
+    const int long_percent = argc > 3 ? std::atoi(argv[3]) : 50;
+
+    // `distinct` names that repeat across the records, long_percent of them over 23 characters
+    std::vector<std::string> names;
+    for (int i = 0; i < distinct; ++i) {
+        bool is_long = i % 100 < long_percent;
+        names.push_back((is_long ? "Customer With A Long Family Name " : "Customer ") + std::to_string(i));
+    }
+
+    trace = false;
+    printf("\n%d records, %d distinct names, %d%% longer than %zu characters (ns per object)\n",
+           count, distinct, long_percent, PersonName::kInlineSize);
+    printTimings("HeapPerson (new char[])", benchmark<HeapPerson>(count, [&names](std::vector<HeapPerson>& people, int i) {
+        people.emplace_back(i, names[i % names.size()].c_str());
+    }));
+    printTimings("Person (inline + heap)", benchmark<Person>(count, [&names](std::vector<Person>& people, int i) {
+        people.emplace_back(i, names[i % names.size()].c_str());
+    }));
+    printTimings("Person (interned)", benchmark<Person>(count, [&names](std::vector<Person>& people, int i) {
+        people.emplace_back(i, intern(names[i % names.size()]));
+    }));
+    printf("  %zu names in the NameTable\n", nameTable().size());
+
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,738 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Adaptive Radix Tree (ART), Leis et al.
+// Compared to the Trie in trie.cpp:
+// 1. Path compression: a chain of single-child nodes collapses into one inner node
+//    whose "prefix" stores the skipped bytes, so long keys no longer mean deep trees.
+// 2. Adaptive fan-out: inner nodes start as Node4 and grow to Node16, Node48 and Node256
+//    only when they need to, instead of every node paying for all 27 children.
+// 3. Leaves keep the full key, so a lookup ends with one key comparison.
+// Keys are compared byte-wise, so iteration order is lexicographic. Integer keys are
+// stored big-endian (see integerKey) which keeps their numeric order.
+
+enum class NodeType : uint8_t { Leaf, Node4, Node16, Node48, Node256 };
+
+template <typename V>
+class AdaptiveRadixTree {
+private:
+    struct Node {
+        NodeType type;
+        explicit Node(NodeType type): type{type} {}
+    };
+
+    struct Leaf : Node {
+        std::string key;
+        V value;
+        Leaf(std::string key, V value): Node(NodeType::Leaf), key{std::move(key)}, value{std::move(value)} {}
+    };
+
+    struct InnerNode : Node {
+        uint16_t count;
+        std::string prefix;
+        // entry whose key ends exactly after prefix, e.g. "car" when "card" goes on below
+        Leaf* terminal;
+        explicit InnerNode(NodeType type): Node(type), count{0}, terminal{nullptr} {}
+    };
+
+    // Node4 and Node16 keep their key bytes sorted, children[i] belongs to keys[i]
+    struct Node4 : InnerNode {
+        uint8_t keys[4];
+        Node* children[4];
+        Node4(): InnerNode(NodeType::Node4), keys{}, children{} {}
+    };
+
+    struct Node16 : InnerNode {
+        uint8_t keys[16];
+        Node* children[16];
+        Node16(): InnerNode(NodeType::Node16), keys{}, children{} {}
+    };
+
+    // Node48 maps a key byte to slot + 1 in children, 0 means no child
+    struct Node48 : InnerNode {
+        uint8_t child_index[256];
+        Node* children[48];
+        Node48(): InnerNode(NodeType::Node48), child_index{}, children{} {}
+    };
+
+    struct Node256 : InnerNode {
+        Node* children[256];
+        Node256(): InnerNode(NodeType::Node256), children{} {}
+    };
+
+    Node* root;
+    std::size_t entries;
+
+public:
+    AdaptiveRadixTree(): root{nullptr}, entries{0} {}
+
+    ~AdaptiveRadixTree() {
+        destroy(root);
+    }
+
+    AdaptiveRadixTree(const AdaptiveRadixTree&) = delete;
+    AdaptiveRadixTree& operator=(const AdaptiveRadixTree&) = delete;
+
+    std::size_t size() const {
+        return entries;
+    }
+
+    // big-endian encoding with the sign bit flipped, so byte order equals numeric order
+    static std::string integerKey(int64_t value) {
+        uint64_t bits = static_cast<uint64_t>(value) ^ (uint64_t{1} << 63);
+        std::string key(8, '\0');
+        for (int i = 7; i >= 0; --i) {
+            key[i] = static_cast<char>(bits & 0xFF);
+            bits >>= 8;
+        }
+        return key;
+    }
+
+    V* search(const std::string& key) const {
+        Node* node = root;
+        std::size_t depth = 0;
+
+        while (node != nullptr) {
+            if (node->type == NodeType::Leaf) {
+                Leaf* leaf = static_cast<Leaf*>(node);
+                return leaf->key == key ? &leaf->value : nullptr;
+            }
+
+            InnerNode* inner = static_cast<InnerNode*>(node);
+            if (matchPrefix(inner, key, depth) != inner->prefix.size()) {
+                return nullptr;
+            }
+            depth += inner->prefix.size();
+
+            if (depth == key.size()) {
+                return inner->terminal != nullptr ? &inner->terminal->value : nullptr;
+            }
+
+            Node** child = findChild(inner, static_cast<uint8_t>(key[depth]));
+            node = child != nullptr ? *child : nullptr;
+            depth++;
+        }
+        return nullptr;
+    }
+
+    // inserts key, or overwrites the value if key is already present
+    void insert(const std::string& key, V value) {
+        Node** slot = &root;
+        std::size_t depth = 0;
+
+        while (true) {
+            Node* node = *slot;
+
+            if (node == nullptr) {
+                *slot = new Leaf(key, std::move(value));
+                entries++;
+                return;
+            }
+
+            if (node->type == NodeType::Leaf) {
+                Leaf* leaf = static_cast<Leaf*>(node);
+                if (leaf->key == key) {
+                    leaf->value = std::move(value);
+                    return;
+                }
+
+                // both keys share key[depth, depth + common), split below the common part
+                std::size_t common = 0;
+                while (depth + common < key.size() && depth + common < leaf->key.size() &&
+                       key[depth + common] == leaf->key[depth + common]) {
+                    common++;
+                }
+
+                Node4* split = new Node4();
+                split->prefix = key.substr(depth, common);
+                std::size_t split_depth = depth + common;
+                attach(split, leaf, split_depth);
+                attach(split, new Leaf(key, std::move(value)), split_depth);
+                *slot = split;
+                entries++;
+                return;
+            }
+
+            InnerNode* inner = static_cast<InnerNode*>(node);
+            std::size_t matched = matchPrefix(inner, key, depth);
+
+            if (matched < inner->prefix.size()) {
+                // key leaves the compressed path halfway, the old node moves one level down
+                Node4* split = new Node4();
+                split->prefix = inner->prefix.substr(0, matched);
+                uint8_t old_byte = static_cast<uint8_t>(inner->prefix[matched]);
+                inner->prefix.erase(0, matched + 1);
+                addChild(split, old_byte, inner);
+                attach(split, new Leaf(key, std::move(value)), depth + matched);
+                *slot = split;
+                entries++;
+                return;
+            }
+
+            depth += inner->prefix.size();
+            if (depth == key.size()) {
+                if (inner->terminal != nullptr) {
+                    inner->terminal->value = std::move(value);
+                } else {
+                    inner->terminal = new Leaf(key, std::move(value));
+                    entries++;
+                }
+                return;
+            }
+
+            uint8_t byte = static_cast<uint8_t>(key[depth]);
+            Node** child = findChild(inner, byte);
+            if (child == nullptr) {
+                if (isFull(inner)) {
+                    inner = grow(inner);
+                    *slot = inner;
+                }
+                addChild(inner, byte, new Leaf(key, std::move(value)));
+                entries++;
+                return;
+            }
+
+            slot = child;
+            depth++;
+        }
+    }
+
+    // returns false when key was not present
+    bool remove(const std::string& key) {
+        Node** parent_slot = nullptr;
+        Node** slot = &root;
+        std::size_t depth = 0;
+        uint8_t byte = 0;
+
+        while (*slot != nullptr) {
+            Node* node = *slot;
+
+            if (node->type == NodeType::Leaf) {
+                Leaf* leaf = static_cast<Leaf*>(node);
+                if (leaf->key != key) {
+                    return false;
+                }
+
+                delete leaf;
+                entries--;
+                if (parent_slot == nullptr) {
+                    root = nullptr;
+                } else {
+                    InnerNode* parent = static_cast<InnerNode*>(*parent_slot);
+                    removeChild(parent, byte);
+                    *parent_slot = shrink(parent);
+                }
+                return true;
+            }
+
+            InnerNode* inner = static_cast<InnerNode*>(node);
+            if (matchPrefix(inner, key, depth) != inner->prefix.size()) {
+                return false;
+            }
+            depth += inner->prefix.size();
+
+            if (depth == key.size()) {
+                if (inner->terminal == nullptr) {
+                    return false;
+                }
+                delete inner->terminal;
+                inner->terminal = nullptr;
+                entries--;
+                *slot = shrink(inner);
+                return true;
+            }
+
+            byte = static_cast<uint8_t>(key[depth]);
+            Node** child = findChild(inner, byte);
+            if (child == nullptr) {
+                return false;
+            }
+
+            parent_slot = slot;
+            slot = child;
+            depth++;
+        }
+        return false;
+    }
+
+    // calls visitor(key, value) for every entry starting with prefix, in key order
+    template <typename Visitor>
+    void forEachWithPrefix(const std::string& prefix, Visitor&& visitor) const {
+        Node* node = root;
+        std::size_t depth = 0;
+
+        while (node != nullptr && depth < prefix.size()) {
+            if (node->type == NodeType::Leaf) {
+                Leaf* leaf = static_cast<Leaf*>(node);
+                if (leaf->key.compare(0, prefix.size(), prefix) != 0) {
+                    return;
+                }
+                break;
+            }
+
+            InnerNode* inner = static_cast<InnerNode*>(node);
+            std::size_t matched = matchPrefix(inner, prefix, depth);
+            if (depth + matched == prefix.size()) {
+                // prefix ends inside (or right at the end of) the compressed path
+                break;
+            }
+            if (matched != inner->prefix.size()) {
+                return;
+            }
+            depth += inner->prefix.size();
+
+            Node** child = findChild(inner, static_cast<uint8_t>(prefix[depth]));
+            node = child != nullptr ? *child : nullptr;
+            depth++;
+        }
+
+        if (node != nullptr) {
+            visitInOrder(node, visitor);
+        }
+    }
+
+private:
+    // number of bytes of inner->prefix that match key starting at depth
+    static std::size_t matchPrefix(const InnerNode* inner, const std::string& key, std::size_t depth) {
+        std::size_t limit = std::min(inner->prefix.size(), key.size() - std::min(depth, key.size()));
+        std::size_t matched = 0;
+        while (matched < limit && inner->prefix[matched] == key[depth + matched]) {
+            matched++;
+        }
+        return matched;
+    }
+
+    static Node** findChild(InnerNode* inner, uint8_t byte) {
+        switch (inner->type) {
+            case NodeType::Node4: {
+                Node4* node = static_cast<Node4*>(inner);
+                for (int i = 0; i < node->count; ++i) {
+                    if (node->keys[i] == byte) {
+                        return &node->children[i];
+                    }
+                }
+                return nullptr;
+            }
+            case NodeType::Node16: {
+                Node16* node = static_cast<Node16*>(inner);
+#if defined(__SSE2__)
+                // compare all 16 key bytes at once, mask off unused slots
+                __m128i needle = _mm_set1_epi8(static_cast<char>(byte));
+                __m128i haystack = _mm_loadu_si128(reinterpret_cast<const __m128i*>(node->keys));
+                int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(needle, haystack)) & ((1 << node->count) - 1);
+                if (mask != 0) {
+                    return &node->children[__builtin_ctz(mask)];
+                }
+                return nullptr;
+#else
+                for (int i = 0; i < node->count; ++i) {
+                    if (node->keys[i] == byte) {
+                        return &node->children[i];
+                    }
+                }
+                return nullptr;
+#endif
+            }
+            case NodeType::Node48: {
+                Node48* node = static_cast<Node48*>(inner);
+                if (node->child_index[byte] == 0) {
+                    return nullptr;
+                }
+                return &node->children[node->child_index[byte] - 1];
+            }
+            case NodeType::Node256: {
+                Node256* node = static_cast<Node256*>(inner);
+                return node->children[byte] != nullptr ? &node->children[byte] : nullptr;
+            }
+            default:
+                return nullptr;
+        }
+    }
+
+    static bool isFull(const InnerNode* inner) {
+        switch (inner->type) {
+            case NodeType::Node4: return inner->count == 4;
+            case NodeType::Node16: return inner->count == 16;
+            case NodeType::Node48: return inner->count == 48;
+            default: return false;
+        }
+    }
+
+    // caller makes sure the node has room and byte is not present yet
+    static void addChild(InnerNode* inner, uint8_t byte, Node* child) {
+        switch (inner->type) {
+            case NodeType::Node4:
+                insertSorted(static_cast<Node4*>(inner)->keys, static_cast<Node4*>(inner)->children,
+                             inner->count, byte, child);
+                break;
+            case NodeType::Node16:
+                insertSorted(static_cast<Node16*>(inner)->keys, static_cast<Node16*>(inner)->children,
+                             inner->count, byte, child);
+                break;
+            case NodeType::Node48: {
+                Node48* node = static_cast<Node48*>(inner);
+                int slot = 0;
+                while (node->children[slot] != nullptr) {
+                    slot++;
+                }
+                node->children[slot] = child;
+                node->child_index[byte] = static_cast<uint8_t>(slot + 1);
+                break;
+            }
+            case NodeType::Node256:
+                static_cast<Node256*>(inner)->children[byte] = child;
+                break;
+            default:
+                return;
+        }
+        inner->count++;
+    }
+
+    static void insertSorted(uint8_t* keys, Node** children, int count, uint8_t byte, Node* child) {
+        int position = 0;
+        while (position < count && keys[position] < byte) {
+            position++;
+        }
+        std::memmove(keys + position + 1, keys + position, count - position);
+        std::memmove(children + position + 1, children + position, (count - position) * sizeof(Node*));
+        keys[position] = byte;
+        children[position] = child;
+    }
+
+    static void removeChild(InnerNode* inner, uint8_t byte) {
+        switch (inner->type) {
+            case NodeType::Node4:
+                eraseSorted(static_cast<Node4*>(inner)->keys, static_cast<Node4*>(inner)->children,
+                            inner->count, byte);
+                break;
+            case NodeType::Node16:
+                eraseSorted(static_cast<Node16*>(inner)->keys, static_cast<Node16*>(inner)->children,
+                            inner->count, byte);
+                break;
+            case NodeType::Node48: {
+                Node48* node = static_cast<Node48*>(inner);
+                node->children[node->child_index[byte] - 1] = nullptr;
+                node->child_index[byte] = 0;
+                break;
+            }
+            case NodeType::Node256:
+                static_cast<Node256*>(inner)->children[byte] = nullptr;
+                break;
+            default:
+                return;
+        }
+        inner->count--;
+    }
+
+    static void eraseSorted(uint8_t* keys, Node** children, int count, uint8_t byte) {
+        int position = 0;
+        while (keys[position] != byte) {
+            position++;
+        }
+        std::memmove(keys + position, keys + position + 1, count - position - 1);
+        std::memmove(children + position, children + position + 1, (count - position - 1) * sizeof(Node*));
+    }
+
+    // hands prefix and terminal over to a bigger node and frees the old one
+    template <typename From, typename To>
+    static To* moveHeader(From* from, To* to) {
+        to->prefix = std::move(from->prefix);
+        to->terminal = from->terminal;
+        delete from;
+        return to;
+    }
+
+    static InnerNode* grow(InnerNode* inner) {
+        switch (inner->type) {
+            case NodeType::Node4: {
+                Node4* node = static_cast<Node4*>(inner);
+                Node16* bigger = new Node16();
+                std::memcpy(bigger->keys, node->keys, node->count);
+                std::memcpy(bigger->children, node->children, node->count * sizeof(Node*));
+                bigger->count = node->count;
+                return moveHeader(node, bigger);
+            }
+            case NodeType::Node16: {
+                Node16* node = static_cast<Node16*>(inner);
+                Node48* bigger = new Node48();
+                for (int i = 0; i < node->count; ++i) {
+                    bigger->children[i] = node->children[i];
+                    bigger->child_index[node->keys[i]] = static_cast<uint8_t>(i + 1);
+                }
+                bigger->count = node->count;
+                return moveHeader(node, bigger);
+            }
+            case NodeType::Node48: {
+                Node48* node = static_cast<Node48*>(inner);
+                Node256* bigger = new Node256();
+                for (int byte = 0; byte < 256; ++byte) {
+                    if (node->child_index[byte] != 0) {
+                        bigger->children[byte] = node->children[node->child_index[byte] - 1];
+                    }
+                }
+                bigger->count = node->count;
+                return moveHeader(node, bigger);
+            }
+            default:
+                return inner;
+        }
+    }
+
+    // called after a removal; returns whatever should now hang in the parent slot
+    static Node* shrink(InnerNode* inner) {
+        if (inner->count == 0) {
+            // only a terminal left (or nothing at all), it becomes a plain leaf
+            Node* leaf = inner->terminal;
+            inner->terminal = nullptr;
+            freeInner(inner);
+            return leaf;
+        }
+
+        switch (inner->type) {
+            case NodeType::Node4: {
+                Node4* node = static_cast<Node4*>(inner);
+                if (node->count > 1 || node->terminal != nullptr) {
+                    return node;
+                }
+
+                // a single child left: merge this node's path into it
+                Node* child = node->children[0];
+                if (child->type != NodeType::Leaf) {
+                    InnerNode* next = static_cast<InnerNode*>(child);
+                    next->prefix = node->prefix + static_cast<char>(node->keys[0]) + next->prefix;
+                }
+                delete node;
+                return child;
+            }
+            case NodeType::Node16: {
+                Node16* node = static_cast<Node16*>(inner);
+                if (node->count > 3) {
+                    return node;
+                }
+                Node4* smaller = new Node4();
+                std::memcpy(smaller->keys, node->keys, node->count);
+                std::memcpy(smaller->children, node->children, node->count * sizeof(Node*));
+                smaller->count = node->count;
+                return moveHeader(node, smaller);
+            }
+            case NodeType::Node48: {
+                Node48* node = static_cast<Node48*>(inner);
+                if (node->count > 12) {
+                    return node;
+                }
+                Node16* smaller = new Node16();
+                for (int byte = 0; byte < 256; ++byte) {
+                    if (node->child_index[byte] != 0) {
+                        smaller->keys[smaller->count] = static_cast<uint8_t>(byte);
+                        smaller->children[smaller->count] = node->children[node->child_index[byte] - 1];
+                        smaller->count++;
+                    }
+                }
+                return moveHeader(node, smaller);
+            }
+            case NodeType::Node256: {
+                Node256* node = static_cast<Node256*>(inner);
+                if (node->count > 36) {
+                    return node;
+                }
+                Node48* smaller = new Node48();
+                for (int byte = 0; byte < 256; ++byte) {
+                    if (node->children[byte] != nullptr) {
+                        smaller->children[smaller->count] = node->children[byte];
+                        smaller->child_index[byte] = static_cast<uint8_t>(smaller->count + 1);
+                        smaller->count++;
+                    }
+                }
+                return moveHeader(node, smaller);
+            }
+            default:
+                return inner;
+        }
+    }
+
+    // calls fn(child) for every child of inner in ascending key byte order
+    template <typename Fn>
+    static void forEachChild(InnerNode* inner, Fn&& fn) {
+        switch (inner->type) {
+            case NodeType::Node4: {
+                Node4* node = static_cast<Node4*>(inner);
+                for (int i = 0; i < node->count; ++i) {
+                    fn(node->children[i]);
+                }
+                break;
+            }
+            case NodeType::Node16: {
+                Node16* node = static_cast<Node16*>(inner);
+                for (int i = 0; i < node->count; ++i) {
+                    fn(node->children[i]);
+                }
+                break;
+            }
+            case NodeType::Node48: {
+                Node48* node = static_cast<Node48*>(inner);
+                for (int byte = 0; byte < 256; ++byte) {
+                    if (node->child_index[byte] != 0) {
+                        fn(node->children[node->child_index[byte] - 1]);
+                    }
+                }
+                break;
+            }
+            case NodeType::Node256: {
+                Node256* node = static_cast<Node256*>(inner);
+                for (int byte = 0; byte < 256; ++byte) {
+                    if (node->children[byte] != nullptr) {
+                        fn(node->children[byte]);
+                    }
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    template <typename Visitor>
+    static void visitInOrder(Node* node, Visitor& visitor) {
+        if (node->type == NodeType::Leaf) {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            visitor(static_cast<const std::string&>(leaf->key), static_cast<const V&>(leaf->value));
+            return;
+        }
+
+        InnerNode* inner = static_cast<InnerNode*>(node);
+        if (inner->terminal != nullptr) {
+            visitor(static_cast<const std::string&>(inner->terminal->key),
+                    static_cast<const V&>(inner->terminal->value));
+        }
+        forEachChild(inner, [&visitor](Node* child) { visitInOrder(child, visitor); });
+    }
+
+    // deletes an inner node (not its children) through its real type
+    static void freeInner(InnerNode* inner) {
+        delete inner->terminal;
+        switch (inner->type) {
+            case NodeType::Node4: delete static_cast<Node4*>(inner); break;
+            case NodeType::Node16: delete static_cast<Node16*>(inner); break;
+            case NodeType::Node48: delete static_cast<Node48*>(inner); break;
+            case NodeType::Node256: delete static_cast<Node256*>(inner); break;
+            default: break;
+        }
+    }
+
+    static void destroy(Node* node) {
+        if (node == nullptr) {
+            return;
+        }
+
+        if (node->type == NodeType::Leaf) {
+            delete static_cast<Leaf*>(node);
+            return;
+        }
+
+        InnerNode* inner = static_cast<InnerNode*>(node);
+        forEachChild(inner, destroy);
+        freeInner(inner);
+    }
+
+    // puts child below node: as its terminal when its key ends at depth, else under key[depth]
+    static void attach(Node4* node, Leaf* leaf, std::size_t depth) {
+        if (leaf->key.size() == depth) {
+            node->terminal = leaf;
+        } else {
+            addChild(node, static_cast<uint8_t>(leaf->key[depth]), leaf);
+        }
+    }
+};
+
+int main(int argc, char* argv[]) {
+
+    AdaptiveRadixTree<int> art;
+    art.insert("romane", 1);
+    art.insert("romanus", 2);
+    art.insert("romulus", 3);
+    art.insert("rubens", 4);
+    art.insert("ruber", 5);
+    art.insert("rubicon", 6);
+    art.insert("rubicundus", 7);
+    art.insert("rom", 8);
+
+    std::cout << "Entries starting with \"rom\":" << std::endl;
+    art.forEachWithPrefix("rom", [](const std::string& key, int value) {
+        std::cout << "  " << key << " -> " << value << std::endl;
+    });
+
+    art.remove("romanus");
+    art.remove("rom");
+    std::cout << "After removing \"romanus\" and \"rom\":" << std::endl;
+    art.forEachWithPrefix("r", [](const std::string& key, int value) {
+        std::cout << "  " << key << " -> " << value << std::endl;
+    });
+
+    // integer keys keep their numeric order
+    AdaptiveRadixTree<std::string> by_id;
+    for (int64_t id : {42, -7, 1000000, 0, 256}) {
+        by_id.insert(AdaptiveRadixTree<std::string>::integerKey(id), "id " + std::to_string(id));
+    }
+    std::cout << "Integer keys in order:" << std::endl;
+    by_id.forEachWithPrefix("", [](const std::string&, const std::string& value) {
+        std::cout << "  " << value << std::endl;
+    });
+
+    // lookups against std::map on random 16-byte keys
+    const int count = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    std::mt19937_64 rng{42};
+    std::vector<std::string> keys;
+    keys.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        std::string key(16, '\0');
+        for (auto& c : key) {
+            c = static_cast<char>('a' + rng() % 26);
+        }
+        keys.push_back(std::move(key));
+    }
+
+    AdaptiveRadixTree<int> bench_art;
+    std::map<std::string, int> bench_map;
+    for (int i = 0; i < count; ++i) {
+        bench_art.insert(keys[i], i);
+        bench_map.emplace(keys[i], i);
+    }
+    std::shuffle(keys.begin(), keys.end(), rng);
+
+    long long checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (auto& key : keys) {
+        checksum += *bench_art.search(key);
+    }
+    auto art_time = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (auto& key : keys) {
+        checksum -= bench_map.find(key)->second;
+    }
+    auto map_time = std::chrono::steady_clock::now() - start;
+
+    std::cout << "\n" << count << " lookups (checksum " << checksum << ")" << std::endl;
+    std::cout << "  AdaptiveRadixTree: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(art_time).count() << " ms" << std::endl;
+    std::cout << "  std::map:          "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(map_time).count() << " ms" << std::endl;
+
+    for (auto& key : keys) {
+        bench_art.remove(key);
+    }
+    std::cout << "Entries left after removing all keys: " << bench_art.size() << std::endl;
+
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <memory_resource>
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
@@ -13,6 +14,9 @@
 //   - Remove
 //   - Search
 //   - Print traversal
+//
+// Nodes and their key/child arrays are allocated from the memory_resource passed to the
+// constructor (the default resource otherwise).
 
 template <typename Key, int T = 3>  // T is the minimum degree, must be >= 2
 class BTree {
@@ -21,10 +25,10 @@ class BTree {
 private:
     struct Node {
         bool is_leaf;
-        std::vector<Key> keys;
-        std::vector<Node*> children; 
+        std::pmr::vector<Key> keys;
+        std::pmr::vector<Node*> children; 
 
-        Node(bool leaf) : is_leaf(leaf) {
+        Node(bool leaf, std::pmr::memory_resource* resource) : is_leaf(leaf), keys(resource), children(resource) {
             // Maximum keys: 2T-1
             // Maximum children: 2T (for non-leaf)
             keys.reserve(2*T - 1);
@@ -33,6 +37,16 @@ private:
     };
 
     Node* root;
+    std::pmr::memory_resource* resource;
+
+    Node* create_node(bool leaf) {
+        return new (resource->allocate(sizeof(Node), alignof(Node))) Node(leaf, resource);
+    }
+
+    void destroy_node(Node* node) {
+        node->~Node();
+        resource->deallocate(node, sizeof(Node), alignof(Node));
+    }
 
     // Utility function to search a key in a subtree rooted with this node.
     // Returns true if present.
@@ -62,7 +76,7 @@ private:
     // Splits the full child y of node x at given index i.
     void split_child(Node* x, int i) {
         Node* y = x->children[i];
-        Node* z = new Node(y->is_leaf);
+        Node* z = create_node(y->is_leaf);
         
         // Move the last (T-1) keys of y to z
         for (int j = 0; j < T-1; j++) {
@@ -319,12 +333,13 @@ private:
         x->keys.erase(x->keys.begin()+idx);
         x->children.erase(x->children.begin()+idx+1);
 
-        delete sibling;
+        destroy_node(sibling);
     }
 
 public:
     // Constructor
-    BTree() : root(nullptr) {}
+    explicit BTree(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : root(nullptr), resource(resource) {}
 
     // Search the given key in the B-Tree
     bool search(const Key& key) const {
@@ -335,12 +350,12 @@ public:
     void insert(const Key& k) {
         // If tree is empty
         if (!root) {
-            root = new Node(true);
+            root = create_node(true);
             root->keys.push_back(k);  // Insert key
         } else {
             // If root is full, then tree grows in height
             if ((int)root->keys.size() == 2*T-1) {
-                Node* s = new Node(false);
+                Node* s = create_node(false);
                 s->children.push_back(root);
 
                 // Split the old root
@@ -375,7 +390,7 @@ public:
             } else {
                 root = nullptr;
             }
-            delete tmp;
+            destroy_node(tmp);
         }
     }
 
@@ -404,7 +419,7 @@ private:
                 delete_subtree(c);
             }
         }
-        delete node;
+        destroy_node(node);
     }
 };
 
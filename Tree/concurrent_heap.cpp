@@ -0,0 +1,235 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+#include "heap.h"
+
+// Concurrent priority queue for many producer and consumer threads.
+// A single Heap behind one mutex serializes every thread on the root. The MultiQueue
+// (Rihani, Sanders, Dementiev) instead keeps many small heaps, each with its own lock:
+// - heapInsert pushes into a random heap whose lock is free
+// - heapRemoveMax looks at the cached top of `choices` random heaps and pops the best one
+// The result is relaxed: heapRemoveMax returns one of the highest elements, not always the
+// highest one. More heaps means less contention, more choices means stricter ordering;
+// a MultiQueue with one heap behaves exactly like a locked Heap.
+
+// priority used to compare the cached tops, TaskRecord-style types expose `priority`
+template <class T>
+struct PriorityOf {
+    long long operator()(const T& value) const {
+        return static_cast<long long>(value.priority);
+    }
+};
+
+template <class T, class Priority = PriorityOf<T>>
+class MultiQueue {
+private:
+    static constexpr long long kEmpty = -1;
+
+    // each heap on its own cache line so neighbours don't share lock traffic
+    struct alignas(64) Queue {
+        std::mutex lock;
+        Heap<T> heap;
+        std::atomic<long long> top{kEmpty};
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    int choices;
+    Priority priorityOf;
+    std::atomic<long long> failed_locks{0};
+
+public:
+    // queue_count heaps; choices heaps are compared per removal (both at least 1)
+    MultiQueue(int queue_count, int choices = 2): choices{choices < 1 ? 1 : choices} {
+        for (int i = 0; i < (queue_count < 1 ? 1 : queue_count); ++i) {
+            queues.push_back(std::make_unique<Queue>());
+        }
+    }
+
+    void heapInsert(const T& value) {
+        for (int attempt = 0; ; ++attempt) {
+            Queue& queue = *queues[randomIndex()];
+            if (!queue.lock.try_lock()) {
+                failed_locks.fetch_add(1, std::memory_order_relaxed);
+                // with few heaps every one may be busy, stop spinning and wait for this one
+                if (attempt < static_cast<int>(queues.size())) {
+                    continue;
+                }
+                queue.lock.lock();
+            }
+            queue.heap.heapInsert(value);
+            refreshTop(queue);
+            queue.lock.unlock();
+            return;
+        }
+    }
+
+    // nullopt only once every heap has been seen empty
+    std::optional<T> heapRemoveMax() {
+        for (int attempt = 0; attempt < 2 * static_cast<int>(queues.size()); ++attempt) {
+            Queue* best = nullptr;
+            long long best_top = kEmpty;
+            for (int c = 0; c < choices; ++c) {
+                Queue* candidate = queues[randomIndex()].get();
+                long long top = candidate->top.load(std::memory_order_relaxed);
+                if (top > best_top) {
+                    best = candidate;
+                    best_top = top;
+                }
+            }
+
+            if (best == nullptr) {
+                continue;
+            }
+            if (!best->lock.try_lock()) {
+                failed_locks.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            // the cached top may be stale, the heap could have been emptied meanwhile
+            std::optional<T> removed = best->heap.heapRemoveMax();
+            refreshTop(*best);
+            best->lock.unlock();
+            if (removed) {
+                return removed;
+            }
+        }
+
+        // random probes kept missing, sweep every heap before reporting empty
+        for (auto& queue : queues) {
+            std::lock_guard<std::mutex> guard{queue->lock};
+            std::optional<T> removed = queue->heap.heapRemoveMax();
+            refreshTop(*queue);
+            if (removed) {
+                return removed;
+            }
+        }
+        return std::nullopt;
+    }
+
+    long long failedLocks() const {
+        return failed_locks.load();
+    }
+
+private:
+    void refreshTop(Queue& queue) {
+        queue.top.store(queue.heap.empty() ? kEmpty : priorityOf(queue.heap.top()), std::memory_order_relaxed);
+    }
+
+    int randomIndex() {
+        thread_local std::minstd_rand rng{std::random_device{}()};
+        return static_cast<int>(rng() % queues.size());
+    }
+};
+
+// the baseline: one Heap, one mutex
+template <class T>
+class LockedHeap {
+private:
+    std::mutex lock;
+    Heap<T> heap;
+    std::atomic<long long> failed_locks{0};
+
+public:
+    void heapInsert(const T& value) {
+        acquire();
+        heap.heapInsert(value);
+        lock.unlock();
+    }
+
+    std::optional<T> heapRemoveMax() {
+        acquire();
+        std::optional<T> removed = heap.heapRemoveMax();
+        lock.unlock();
+        return removed;
+    }
+
+    long long failedLocks() const {
+        return failed_locks.load();
+    }
+
+private:
+    // counts how often a thread found the lock taken
+    void acquire() {
+        if (!lock.try_lock()) {
+            failed_locks.fetch_add(1, std::memory_order_relaxed);
+            lock.lock();
+        }
+    }
+};
+
+// producers push items_per_producer tasks each while consumers pop until all are gone
+template <class Queue>
+void benchmark(const char* name, Queue& queue, int producers, int consumers, int items_per_producer) {
+    const long long total = static_cast<long long>(producers) * items_per_producer;
+    std::atomic<long long> removed{0};
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, p, items_per_producer] {
+            std::minstd_rand rng(p + 1);
+            for (int i = 0; i < items_per_producer; ++i) {
+                queue.heapInsert(TaskRecord(rng() % 1000000, "task"));
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&queue, &removed, total] {
+            while (removed.load(std::memory_order_relaxed) < total) {
+                if (queue.heapRemoveMax()) {
+                    removed.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "  " << name << ": " << static_cast<long long>(2 * total / seconds) << " ops/s, "
+              << queue.failedLocks() << " contended lock attempts" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    MultiQueue<TaskRecord> tasks{4};
+    tasks.heapInsert(TaskRecord(10, "Task A"));
+    tasks.heapInsert(TaskRecord(5, "Task B"));
+    tasks.heapInsert(TaskRecord(20, "Task C"));
+    tasks.heapInsert(TaskRecord(1, "Task D"));
+
+    // relaxed order: usually, but not always, highest priority first
+    while (auto task = tasks.heapRemoveMax()) {
+        std::cout << "Deleted: " << task->task_name << " (Priority: " << task->priority << ")\n";
+    }
+
+    const int producers = argc > 1 ? std::atoi(argv[1]) : 32;
+    const int consumers = argc > 2 ? std::atoi(argv[2]) : 32;
+    const int items = argc > 3 ? std::atoi(argv[3]) : 20000;
+    const int threads = producers + consumers;
+
+    std::cout << "\n" << producers << " producers, " << consumers << " consumers, "
+              << items << " tasks per producer" << std::endl;
+
+    LockedHeap<TaskRecord> locked;
+    benchmark("LockedHeap             ", locked, producers, consumers, items);
+
+    MultiQueue<TaskRecord> strict{1, 1};
+    benchmark("MultiQueue(1 heap)     ", strict, producers, consumers, items);
+
+    MultiQueue<TaskRecord> relaxed{2 * threads, 2};
+    benchmark("MultiQueue(2 x threads)", relaxed, producers, consumers, items);
+
+    MultiQueue<TaskRecord> stricter{2 * threads, 4};
+    benchmark("MultiQueue(4 choices)  ", stricter, producers, consumers, items);
+
+    return 0;
+}
@@ -0,0 +1,383 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Read-mostly Trie for dictionaries that are queried by many threads and rebuilt now and then.
+// Published nodes are never modified. Writers copy the path they change (copy-on-write),
+// then swap the root pointer atomically, so a reader always sees either the old or the new
+// dictionary and never waits for a writer.
+// Replaced nodes cannot be freed right away because a reader may still be walking them.
+// They are retired with the current epoch and freed once every reader has moved past it
+// (epoch-based reclamation).
+
+class EpochManager {
+private:
+    static constexpr int kMaxReaders = 512;
+    static constexpr uint64_t kIdle = UINT64_MAX;
+
+    // one cache line per reader so announcing an epoch does not bounce other readers' lines
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> epoch{kIdle};
+        std::atomic<bool> in_use{false};
+    };
+
+    std::atomic<uint64_t> global_epoch{1};
+    Slot slots[kMaxReaders];
+
+    // a thread claims a slot on its first read and gives it back when it exits
+    struct ThreadSlot {
+        EpochManager* manager = nullptr;
+        int index = -1;
+
+        ~ThreadSlot() {
+            if (manager != nullptr) {
+                manager->slots[index].epoch.store(kIdle);
+                manager->slots[index].in_use.store(false);
+            }
+        }
+    };
+
+    Slot& threadSlot() {
+        thread_local ThreadSlot thread_slot;
+        if (thread_slot.manager == nullptr) {
+            for (int i = 0; i < kMaxReaders; ++i) {
+                bool expected = false;
+                if (slots[i].in_use.compare_exchange_strong(expected, true)) {
+                    thread_slot.manager = this;
+                    thread_slot.index = i;
+                    break;
+                }
+            }
+            if (thread_slot.manager == nullptr) {
+                std::cerr << "EpochManager: more than " << kMaxReaders << " reader threads\n";
+                std::terminate();
+            }
+        }
+        return slots[thread_slot.index];
+    }
+
+    EpochManager() = default;
+
+public:
+    static EpochManager& instance() {
+        static EpochManager manager;
+        return manager;
+    }
+
+    // RAII guard: nodes reachable while it lives are not freed
+    class ReadGuard {
+    private:
+        Slot& slot;
+    public:
+        explicit ReadGuard(EpochManager& manager): slot{manager.threadSlot()} {
+            slot.epoch.store(manager.global_epoch.load());
+        }
+        ~ReadGuard() {
+            slot.epoch.store(kIdle);
+        }
+    };
+
+    uint64_t currentEpoch() const {
+        return global_epoch.load();
+    }
+
+    // starts a new epoch and returns the oldest epoch a reader may still be in
+    uint64_t advance() {
+        global_epoch.fetch_add(1);
+        uint64_t oldest = global_epoch.load();
+        for (auto& slot : slots) {
+            oldest = std::min(oldest, slot.epoch.load());
+        }
+        return oldest;
+    }
+};
+
+class ConcurrentTrie {
+private:
+    struct Node {
+        bool is_entry;
+        std::vector<Node*> children;
+
+        Node(): is_entry{false}, children(27, nullptr) {}
+        Node(const Node& other) = default;
+    };
+
+    // nodes replaced at `epoch`; a whole subtree when the dictionary was reloaded
+    struct Retired {
+        uint64_t epoch;
+        Node* node;
+        bool whole_subtree;
+    };
+
+    std::atomic<Node*> root;
+    std::mutex writer_mutex;
+    std::vector<Retired> retired;
+    EpochManager& epochs;
+
+public:
+    ConcurrentTrie(): root{new Node()}, epochs{EpochManager::instance()} {}
+
+    // no reader may be running when the dictionary itself goes away
+    ~ConcurrentTrie() {
+        for (auto& entry : retired) {
+            free(entry);
+        }
+        destroySubtree(root.load());
+    }
+
+    ConcurrentTrie(const ConcurrentTrie&) = delete;
+    ConcurrentTrie& operator=(const ConcurrentTrie&) = delete;
+
+    // wait-free: two stores to announce the epoch plus one step per character
+    bool search(const std::string& target) {
+        EpochManager::ReadGuard guard{epochs};
+
+        // Store (epoch slot) then load (root) here, store (root) then load (epoch slots) in the
+        // writer: only seq_cst on both sides guarantees that either the writer sees this reader's
+        // epoch or this reader sees the new root. With release/acquire both may read the old
+        // values, and the reader would walk nodes the writer has already freed.
+        Node* node = root.load(std::memory_order_seq_cst);
+        for (char letter : target) {
+            node = node->children[letterToIndex(letter)];
+            if (node == nullptr) {
+                return false;
+            }
+        }
+        return node->is_entry;
+    }
+
+    void insert(const std::string& new_value) {
+        std::lock_guard<std::mutex> lock{writer_mutex};
+
+        std::vector<Node*> old_path;
+        Node* new_root = copyPath(new_value, old_path, true);
+        Node* last = new_root;
+        for (char letter : new_value) {
+            last = last->children[letterToIndex(letter)];
+        }
+        last->is_entry = true;
+
+        publish(new_root, old_path);
+    }
+
+    // returns false when target was not an entry
+    bool remove(const std::string& target) {
+        std::lock_guard<std::mutex> lock{writer_mutex};
+
+        Node* node = root.load();
+        for (char letter : target) {
+            node = node->children[letterToIndex(letter)];
+            if (node == nullptr) {
+                return false;
+            }
+        }
+        if (!node->is_entry) {
+            return false;
+        }
+
+        std::vector<Node*> old_path;
+        Node* new_root = copyPath(target, old_path, false);
+
+        // walk the copied path again, unmark the entry and cut off branches that became empty
+        std::vector<Node*> new_path{new_root};
+        for (char letter : target) {
+            new_path.push_back(new_path.back()->children[letterToIndex(letter)]);
+        }
+        new_path.back()->is_entry = false;
+
+        for (int depth = static_cast<int>(target.size()); depth > 0; --depth) {
+            Node* current = new_path[depth];
+            bool empty = !current->is_entry &&
+                std::all_of(current->children.begin(), current->children.end(),
+                            [](Node* child) { return child == nullptr; });
+            if (!empty) {
+                break;
+            }
+            new_path[depth - 1]->children[letterToIndex(target[depth - 1])] = nullptr;
+            delete current;
+        }
+
+        publish(new_root, old_path);
+        return true;
+    }
+
+    // builds a complete new dictionary off to the side and swaps it in at once
+    void reload(const std::vector<std::string>& words) {
+        Node* new_root = new Node();
+        for (auto& word : words) {
+            Node* node = new_root;
+            for (char letter : word) {
+                Node*& child = node->children[letterToIndex(letter)];
+                if (child == nullptr) {
+                    child = new Node();
+                }
+                node = child;
+            }
+            node->is_entry = true;
+        }
+
+        std::lock_guard<std::mutex> lock{writer_mutex};
+        // seq_cst for the same reason as in publish()
+        Node* old_root = root.exchange(new_root, std::memory_order_seq_cst);
+        retired.push_back({epochs.currentEpoch(), old_root, true});
+        reclaim();
+    }
+
+    std::size_t pendingReclamation() {
+        std::lock_guard<std::mutex> lock{writer_mutex};
+        return retired.size();
+    }
+
+private:
+    int letterToIndex(char next_letter) {
+        return std::tolower(next_letter) - 97;
+    }
+
+    // copies every node from the root along key; missing nodes are created when `create` is set.
+    // The originals are collected in old_path so they can be retired after the swap.
+    Node* copyPath(const std::string& key, std::vector<Node*>& old_path, bool create) {
+        Node* old_node = root.load();
+        Node* new_root = new Node(*old_node);
+        old_path.push_back(old_node);
+
+        Node* parent = new_root;
+        for (char letter : key) {
+            int index = letterToIndex(letter);
+            old_node = parent->children[index];
+
+            Node* copy;
+            if (old_node != nullptr) {
+                copy = new Node(*old_node);
+                old_path.push_back(old_node);
+            } else if (create) {
+                copy = new Node();
+            } else {
+                break;
+            }
+            parent->children[index] = copy;
+            parent = copy;
+        }
+        return new_root;
+    }
+
+    void publish(Node* new_root, const std::vector<Node*>& old_path) {
+        // seq_cst, paired with the load in search(): the epoch slots are read after this store
+        root.store(new_root, std::memory_order_seq_cst);
+
+        uint64_t epoch = epochs.currentEpoch();
+        for (Node* node : old_path) {
+            retired.push_back({epoch, node, false});
+        }
+        reclaim();
+    }
+
+    // frees everything retired before the oldest epoch any reader is still in
+    void reclaim() {
+        uint64_t oldest = epochs.advance();
+
+        auto still_visible = std::partition(retired.begin(), retired.end(),
+            [oldest](const Retired& entry) { return entry.epoch >= oldest; });
+        for (auto it = still_visible; it != retired.end(); ++it) {
+            free(*it);
+        }
+        retired.erase(still_visible, retired.end());
+    }
+
+    void free(const Retired& entry) {
+        if (entry.whole_subtree) {
+            destroySubtree(entry.node);
+        } else {
+            delete entry.node;
+        }
+    }
+
+    // iterative so deep dictionaries cannot overflow the stack
+    void destroySubtree(Node* subtree) {
+        std::vector<Node*> pending{subtree};
+        while (!pending.empty()) {
+            Node* node = pending.back();
+            pending.pop_back();
+            for (Node* child : node->children) {
+                if (child != nullptr) {
+                    pending.push_back(child);
+                }
+            }
+            delete node;
+        }
+    }
+};
+
+int main(int argc, char* argv[]) {
+
+    ConcurrentTrie trie;
+    trie.insert("Ramadhan");
+    trie.insert("Ramadhani");
+    std::cout << "Ramadhan: " << trie.search("Ramadhan") << std::endl;
+
+    trie.remove("Ramadhan");
+    std::cout << "Ramadhan after remove: " << trie.search("Ramadhan") << std::endl;
+    std::cout << "Ramadhani after remove: " << trie.search("Ramadhani") << std::endl;
+
+    // readers query non-stop while the writer reloads the dictionary
+    std::vector<std::string> even_words, odd_words;
+    for (int i = 0; i < 20000; ++i) {
+        std::string word;
+        for (int n = i + 1; n > 0; n /= 26) {
+            word.push_back(static_cast<char>('a' + n % 26));
+        }
+        (i % 2 == 0 ? even_words : odd_words).push_back(word);
+    }
+    trie.reload(even_words);
+
+    const int reader_count = argc > 1 ? std::atoi(argv[1]) : 8;
+    std::atomic<bool> stop{false};
+    std::atomic<long long> lookups{0};
+    std::atomic<long long> worst_ns{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < reader_count; ++r) {
+        readers.emplace_back([&, r] {
+            long long local_lookups = 0;
+            long long local_worst = 0;
+            std::size_t i = r;
+            while (!stop.load(std::memory_order_relaxed)) {
+                const std::string& word = even_words[i++ % even_words.size()];
+                auto start = std::chrono::steady_clock::now();
+                trie.search(word);
+                auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+                local_worst = std::max<long long>(local_worst, elapsed);
+                local_lookups++;
+            }
+            lookups += local_lookups;
+            long long seen = worst_ns.load();
+            while (local_worst > seen && !worst_ns.compare_exchange_weak(seen, local_worst)) {}
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < 10; ++round) {
+        trie.reload(round % 2 == 0 ? odd_words : even_words);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    auto reload_time = std::chrono::steady_clock::now() - start;
+
+    stop = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    std::cout << "\n" << reader_count << " readers, 10 reloads in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(reload_time).count() << " ms" << std::endl;
+    std::cout << "  lookups:             " << lookups.load() << std::endl;
+    std::cout << "  worst lookup:        " << worst_ns.load() / 1000 << " us" << std::endl;
+    std::cout << "  retired, not freed:  " << trie.pendingReclamation() << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <iostream>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Heap properties:
+// Addition: add new node as leaf node, then bubble up based on its prority
+// By design, heaps are balanced trees, here every node has up to D children (4 by default)
+// Removing: swapping the first element (root) with the last element (last index)
+// To restore the tree, we have to walkdown the tree, restoring the heap property at every level
+//
+// Indexed heap: heapInsert returns a handle that stays valid until the element is removed,
+// so updateValue/erase find the element in O(1) instead of looking it up by name.
+// Elements live inline in `values` (indexed by handle) and never move; sifting only moves
+// the int handles in `order`, and `position` maps a handle back to its slot in `order`.
+// All four arrays allocate from the memory_resource given to the constructor (default resource).
+
+class TaskRecord {
+public:
+    unsigned int priority;
+    std::string task_name;
+
+    TaskRecord(unsigned int priority, std::string task_name) : priority(priority), task_name(std::move(task_name)) {}
+    ~TaskRecord() = default;
+
+    bool operator < (const TaskRecord& _task_record) const {
+        return this->priority < _task_record.priority;
+    }
+};
+
+template <class T, int D = 4>
+class Heap {
+    static_assert(D >= 2, "a heap node needs at least two children");
+
+public:
+    explicit Heap(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : values(resource), order(resource), position(resource), free_handles(resource) {}
+    ~Heap() = default;
+
+    // returns the handle of the new element
+    int heapInsert(const T& value);
+    std::optional<T> heapRemoveMax();
+    std::optional<T> heapRemoveMin();
+    void updateValue(int handle, const T& value);
+    bool erase(int handle);
+
+    const T& top() const { return this->values[this->order[0]]; }
+    const T& get(int handle) const { return this->values[handle]; }
+    bool contains(int handle) const {
+        return handle >= 0 && handle < static_cast<int>(this->position.size()) && this->position[handle] >= 0;
+    }
+    int size() const { return static_cast<int>(this->order.size()); }
+    bool empty() const { return this->order.empty(); }
+    void reserve(int capacity);
+
+private:
+    std::pmr::vector<T> values;        // element storage, indexed by handle
+    std::pmr::vector<int> order;       // heap order: order[i] is the handle stored at heap slot i
+    std::pmr::vector<int> position;    // position[handle] is the heap slot of handle, -1 when free
+    std::pmr::vector<int> free_handles;
+
+    bool less(int i, int j) const { return this->values[this->order[i]] < this->values[this->order[j]]; }
+    void place(int index, int handle);
+    void bubbleUp(int index);
+    void bubbleDown(int index);
+    T take(int index);
+};
+
+template <class T, int D>
+void Heap<T, D>::reserve(int capacity) {
+    this->values.reserve(capacity);
+    this->order.reserve(capacity);
+    this->position.reserve(capacity);
+}
+
+template <class T, int D>
+void Heap<T, D>::place(int index, int handle) {
+    this->order[index] = handle;
+    this->position[handle] = index;
+}
+
+template <class T, int D>
+void Heap<T, D>::bubbleUp(int index) {
+    int handle = this->order[index];
+
+    // move parents down into the hole instead of swapping at every level
+    while (index > 0) {
+        int parent_index = (index - 1) / D;
+        if (!(this->values[this->order[parent_index]] < this->values[handle])) {
+            break;
+        }
+        place(index, this->order[parent_index]);
+        index = parent_index;
+    }
+    place(index, handle);
+}
+
+template <class T, int D>
+void Heap<T, D>::bubbleDown(int index) {
+    int handle = this->order[index];
+    const int count = static_cast<int>(this->order.size());
+
+    while (true) {
+        int first_child = D * index + 1;
+        if (first_child >= count) {
+            break;
+        }
+
+        // search the largest priority among the (up to) D children
+        int largest = first_child;
+        int last_child = first_child + D < count ? first_child + D : count;
+        for (int child = first_child + 1; child < last_child; ++child) {
+            if (less(largest, child)) {
+                largest = child;
+            }
+        }
+
+        if (!(this->values[handle] < this->values[this->order[largest]])) {
+            break;
+        }
+        place(index, this->order[largest]);
+        index = largest;
+    }
+    place(index, handle);
+}
+
+template <class T, int D>
+int Heap<T, D>::heapInsert(const T& value) {
+    int handle;
+    if (!this->free_handles.empty()) {
+        handle = this->free_handles.back();
+        this->free_handles.pop_back();
+        this->values[handle] = value;
+    } else {
+        handle = static_cast<int>(this->values.size());
+        this->values.push_back(value);
+        this->position.push_back(-1);
+    }
+
+    this->order.push_back(handle);
+    this->position[handle] = static_cast<int>(this->order.size()) - 1;
+    bubbleUp(static_cast<int>(this->order.size()) - 1);
+    return handle;
+}
+
+// removes the element at heap slot index and fills the gap with the last element
+template <class T, int D>
+T Heap<T, D>::take(int index) {
+    int handle = this->order[index];
+    T removed = std::move(this->values[handle]);
+    this->position[handle] = -1;
+    this->free_handles.push_back(handle);
+
+    int last = this->order.back();
+    this->order.pop_back();
+    if (index < static_cast<int>(this->order.size())) {
+        place(index, last);
+        // the moved element can be out of order in either direction
+        bubbleUp(index);
+        bubbleDown(this->position[last]);
+    }
+    return removed;
+}
+
+template <class T, int D>
+void Heap<T, D>::updateValue(int handle, const T& value) {
+    if (!contains(handle)) {
+        std::cerr << "Invalid handle\n";
+        return;
+    }
+
+    bool increased = this->values[handle] < value;
+    this->values[handle] = value;
+
+    if (increased) {
+        bubbleUp(this->position[handle]);
+    } else {
+        bubbleDown(this->position[handle]);
+    }
+}
+
+template <class T, int D>
+bool Heap<T, D>::erase(int handle) {
+    if (!contains(handle)) {
+        return false;
+    }
+    take(this->position[handle]);
+    return true;
+}
+
+template <class T, int D>
+std::optional<T> Heap<T, D>::heapRemoveMax() {
+    if (this->order.empty()) {
+        return std::nullopt;
+    }
+    return take(0);
+}
+
+template <class T, int D>
+std::optional<T> Heap<T, D>::heapRemoveMin() {
+    if (this->order.empty()) {
+        return std::nullopt;
+    }
+
+    // the minimum is one of the leaves, which start right after the last parent
+    const int count = static_cast<int>(this->order.size());
+    int first_leaf = count > 1 ? (count - 2) / D + 1 : 0;
+    int min_index = first_leaf;
+    for (int i = first_leaf + 1; i < count; ++i) {
+        if (less(i, min_index)) {
+            min_index = i;
+        }
+    }
+    return take(min_index);
+}
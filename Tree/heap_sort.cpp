@@ -1,241 +1,173 @@
-#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <random>
 #include <utility>
 #include <vector>
-#include <memory>
-#include <unordered_map>
-#define ARRAYSIZE 100
-
-// Heap properties:
-// Addition: add new node as leaf node, then bubble up based on its prority
-// By design, heaps are balanced binary trees
-// Removing: swapping the first element (root) with the last element (last index)
-// To restore the tree, we have to walkdown the tree, restoring the heap property at every level
-
-class TaskRecord {
-public:
-    unsigned int priority;
-    std::string task_name;
-
-    TaskRecord(unsigned int priority, std::string task_name) : priority(priority), task_name(std::move(task_name)) {}
-    ~TaskRecord() = default;
-
-    bool operator < (const TaskRecord& _task_record) const {
-        if (this->priority < _task_record.priority) {
-            return true;
-        } else {
-            return false;
+#include "heap.h"
+
+// In-place heap sort over random-access iterators:
+// 1. heapify: sift down every parent from the last one to the root, O(n) in total (Floyd)
+// 2. repeatedly swap the root (max) with the last element of the heap and sift the new root down
+//
+// Sift down is done bottom-up (Floyd's variant): the element taken from the end of the array
+// is almost always small, so instead of comparing it at every level on the way down, we first
+// walk the hole down to a leaf along the larger children (one comparison per level), then move
+// the element up from there to its place, which is usually only a level or two.
+
+// places value into the hole at `hole` inside the heap [first, first + length);
+// the value never moves above `top`
+template <class RandomIt, class Compare>
+void siftDownBottomUp(RandomIt first, std::ptrdiff_t hole, std::ptrdiff_t top, std::ptrdiff_t length,
+                      typename std::iterator_traits<RandomIt>::value_type value, Compare comp) {
+    // walk the hole down to a leaf, pulling the larger child up at every level
+    std::ptrdiff_t child = 2 * hole + 1;
+    while (child < length) {
+        if (child + 1 < length && comp(first[child], first[child + 1])) {
+            child++;
         }
+        first[hole] = std::move(first[child]);
+        hole = child;
+        child = 2 * hole + 1;
     }
-};
-
-template <class T>
-class Heap {
-public:
-    std::vector<std::unique_ptr<T>> arr;
-    int last_index;
-
-    std::unordered_map<std::string, int> taskNameToIndex;
-
-    Heap();
-    ~Heap();
-
-    void heapInsert(const T& value);
-    std::unique_ptr<T> heapRemoveMax();
-    std::unique_ptr<T> heapRemoveMin();
-    void updateValue(const int& index, const T& value);
 
-private:
-    void swapNodes(int i, int j);
-};
-
-template <class T>
-Heap<T>::Heap() {
-    this->arr.resize(ARRAYSIZE);
-    this->last_index = 0;
+    // climb back up until the parent is not smaller than value
+    while (hole > top) {
+        std::ptrdiff_t parent = (hole - 1) / 2;
+        if (!comp(first[parent], value)) {
+            break;
+        }
+        first[hole] = std::move(first[parent]);
+        hole = parent;
+    }
+    first[hole] = std::move(value);
 }
 
-template <class T>
-Heap<T>::~Heap() {
-    this->arr.clear();
-    this->last_index = 0;
+template <class RandomIt, class Compare>
+void makeHeap(RandomIt first, RandomIt last, Compare comp) {
+    std::ptrdiff_t length = last - first;
+    for (std::ptrdiff_t parent = length / 2 - 1; parent >= 0; --parent) {
+        siftDownBottomUp(first, parent, parent, length, std::move(first[parent]), comp);
+    }
 }
 
-template<class T>
-void Heap<T>::swapNodes(int i, int j) {
-    std::swap(this->arr[i], this->arr[j]);
-    this->taskNameToIndex[this->arr[i]->task_name] = i;
-    this->taskNameToIndex[this->arr[j]->task_name] = j;
+// takes the max of the heap [first, first + length) out and stores it at first + length - 1
+template <class RandomIt, class Compare>
+void popHeap(RandomIt first, std::ptrdiff_t length, Compare comp) {
+    auto value = std::move(first[length - 1]);
+    first[length - 1] = std::move(first[0]);
+    siftDownBottomUp(first, 0, 0, length - 1, std::move(value), comp);
 }
 
-template<class T>
-void Heap<T>::heapInsert(const T& value) {
-    if (this->last_index == static_cast<int>(this->arr.size()) - 1) {
-        this->arr.resize(this->arr.size() * 2);
+template <class RandomIt, class Compare>
+void sortHeap(RandomIt first, RandomIt last, Compare comp) {
+    for (std::ptrdiff_t length = last - first; length > 1; --length) {
+        popHeap(first, length, comp);
     }
+}
 
-    this->last_index++;
-    this->arr[this->last_index] = std::make_unique<T>(value);
-    taskNameToIndex[value.task_name] = this->last_index;
-
-    int current_index = this->last_index;
-    int parent_index = std::floor(current_index / 2);
-
-    while (parent_index >= 1 && (*(this->arr[parent_index]) < *(this->arr[current_index]))) {
-        swapNodes(parent_index, current_index);
-        current_index = parent_index;
-        parent_index = std::floor(current_index / 2);
-    }
+template <class RandomIt, class Compare = std::less<>>
+void heap_sort(RandomIt first, RandomIt last, Compare comp = Compare{}) {
+    makeHeap(first, last, comp);
+    sortHeap(first, last, comp);
 }
 
-template<class T>
-void Heap<T>::updateValue(const int &index, const T &value) {
-    if (index < 1 || index > last_index) {
-        std::cerr << "Invalid index\n";
+// top-k mode, same contract as std::partial_sort: the smallest (middle - first) elements
+// end up sorted in [first, middle), the rest in unspecified order
+template <class RandomIt, class Compare = std::less<>>
+void partial_heap_sort(RandomIt first, RandomIt middle, RandomIt last, Compare comp = Compare{}) {
+    std::ptrdiff_t k = middle - first;
+    if (k == 0) {
         return;
     }
 
-    std::unique_ptr<T> old_value = std::move(this->arr[index]);
-    this->taskNameToIndex.erase(old_value->task_name);
-
-    this->arr[index] = std::make_unique<T>(value);
-    this->taskNameToIndex[value.task_name] = index;
-
-    if (*old_value < *this->arr[index]) {
-        // Bubble up
-        int current_index = index;
-        int parent_index = std::floor(current_index / 2);
-        while (parent_index >= 1 && (*(this->arr[parent_index]) < *(this->arr[current_index]))) {
-            swapNodes(parent_index, current_index);
-            current_index = parent_index;
-            parent_index = std::floor(current_index / 2);
-        }
-    } else {
-        // Bubble down
-        int i = index;
-        while (i <= this->last_index) {
-            int swap = i;
-
-            if (2 * i <= this->last_index && (*(this->arr[swap]) < *(this->arr[2 * i]))) {
-                swap = 2 * i;
-            }
-
-            if (2 * i + 1 <= this->last_index && (*(this->arr[swap]) < *(this->arr[2 * i + 1]))) {
-                swap = 2 * i + 1;
-            }
-
-            if (i != swap) {
-                swapNodes(i, swap);
-                i = swap;
-            } else {
-                break;
-            }
+    // keep the k smallest seen so far in a max heap, its root is the one to beat
+    makeHeap(first, middle, comp);
+    for (RandomIt it = middle; it != last; ++it) {
+        if (comp(*it, *first)) {
+            auto value = std::move(*it);
+            *it = std::move(*first);
+            siftDownBottomUp(first, 0, 0, k, std::move(value), comp);
         }
     }
+    sortHeap(first, middle, comp);
 }
 
-template<class T>
-std::unique_ptr<T> Heap<T>::heapRemoveMax() {
-    if (this->last_index == 0) {
-        return nullptr;
-    }
-
-    if (this->last_index == 1) {
-        return std::move(this->arr[1]);
-    }
-
-    // previous max priority
-    std::unique_ptr<T> removed = std::move(this->arr[1]);
-    this->taskNameToIndex.erase(removed->task_name);
-
-    this->arr[1] = std::move(this->arr[this->last_index]);
-    this->taskNameToIndex[this->arr[1]->task_name] = 1;
-
-    // decrease last_index
-    this->last_index--;
-
-    int i = 1;
-    while (i <= this->last_index) {
-        int swap = i;
-
-        // search the largest priority between parent with left child
-        if (2 * i <= this->last_index && (*(this->arr[swap]) < *(this->arr[2 * i]))) {
-            swap = 2 * i;
+// Introsort: quicksort while it behaves, heap_sort once the recursion gets too deep
+// (so the worst case stays O(n log n)), insertion sort for the small leftovers
+template <class RandomIt, class Compare>
+void introSortLoop(RandomIt first, RandomIt last, int depth_limit, Compare comp) {
+    while (last - first > 16) {
+        if (depth_limit == 0) {
+            heap_sort(first, last, comp);
+            return;
         }
-
-        // then will be check between left child and right child if swap has changed to 2 * i
-        if (2 * i + 1 <= this->last_index && (*(this->arr[swap]) < *(this->arr[2 * i + 1]))) {
-            swap = 2 * i + 1;
+        depth_limit--;
+
+        // median of three as pivot, moved to first
+        RandomIt middle = first + (last - first) / 2;
+        RandomIt a = first + 1, b = middle, c = last - 1;
+        if (comp(*b, *a)) std::iter_swap(a, b);
+        if (comp(*c, *b)) std::iter_swap(b, c);
+        if (comp(*b, *a)) std::iter_swap(a, b);
+        std::iter_swap(first, b);
+
+        // Hoare partition around *first
+        RandomIt left = first + 1, right = last;
+        while (true) {
+            while (comp(*left, *first)) ++left;
+            --right;
+            while (comp(*first, *right)) --right;
+            if (!(left < right)) break;
+            std::iter_swap(left, right);
+            ++left;
         }
 
-        // swap it between i and swap
-        if (i != swap) {
-            swapNodes(i, swap);
-
-            // i now as the swap
-            i = swap;
-        } else {
-            break;
-        }
+        // recurse into the right part, loop on the left part
+        introSortLoop(left, last, depth_limit, comp);
+        last = left;
     }
-
-    std::cout << "Deleted: " << removed->task_name << " (Priority: " << removed->priority << ")\n";
-    return std::move(removed);
 }
 
-template<class T>
-std::unique_ptr<T> Heap<T>::heapRemoveMin() {
-    if (this->last_index == 0) {
-        std::cerr << "Heap is empty.\n";
-        return nullptr;
-    }
-
-    if (this->last_index == 1) {
-        return std::move(this->arr[1]);
+template <class RandomIt, class Compare>
+void insertionSort(RandomIt first, RandomIt last, Compare comp) {
+    if (first == last) {
+        return;
     }
-
-    // search the min index
-    int min_index = 1;
-    for (int i = 2; i <= this->last_index; ++i) {
-        if (*(this->arr[i]) < *(this->arr[min_index])) {
-            min_index = i;
+    for (RandomIt it = first + 1; it != last; ++it) {
+        auto value = std::move(*it);
+        RandomIt hole = it;
+        while (hole != first && comp(value, *(hole - 1))) {
+            *hole = std::move(*(hole - 1));
+            --hole;
         }
+        *hole = std::move(value);
     }
+}
 
-    std::unique_ptr<T> removed = std::move(this->arr[min_index]);
-    this->taskNameToIndex.erase(removed->task_name);
-
-    this->arr[min_index] = std::move(this->arr[this->last_index]);
-    this->taskNameToIndex[this->arr[min_index]->task_name] = min_index;
-    this->last_index--;
-
-    int i = min_index;
-    while (i <= this->last_index) {
-        int swap = i;
-
-        if (2 * i <= this->last_index && (*(this->arr[swap]) < *(this->arr[2 * i]))) {
-            swap = 2 * i;
-        }
-
-        if (2 * i + 1 <= this->last_index && (*(this->arr[swap]) < *(this->arr[2 * i + 1]))) {
-            swap = 2 * i + 1;
-        }
-
-        if (i != swap) {
-            swapNodes(i, swap);
-            i = swap;
-        } else {
-            break;
-        }
+template <class RandomIt, class Compare = std::less<>>
+void intro_sort(RandomIt first, RandomIt last, Compare comp = Compare{}) {
+    int depth_limit = 0;
+    for (std::ptrdiff_t n = last - first; n > 1; n >>= 1) {
+        depth_limit += 2;
     }
+    introSortLoop(first, last, depth_limit, comp);
+    insertionSort(first, last, comp);
+}
 
-    std::cout << "Deleted Min: " << removed->task_name << " (Priority: " << removed->priority << ")\n";
-    return std::move(removed);
+template <class Sort>
+long long timeSort(const std::vector<int>& input, Sort sort, bool& sorted_ok, std::ptrdiff_t checked) {
+    std::vector<int> data = input;
+    auto start = std::chrono::steady_clock::now();
+    sort(data);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    sorted_ok = std::is_sorted(data.begin(), data.begin() + checked);
+    return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
 }
 
 int main(int argc, char* argv[]) {
-    Heap<TaskRecord> heap;
-
     std::vector<TaskRecord> tasks = {
         TaskRecord(3, "Task A"),
         TaskRecord(2, "Task B"),
@@ -244,19 +176,47 @@ int main(int argc, char* argv[]) {
         TaskRecord(7, "Task E"),
     };
 
+    // highest priority first
+    heap_sort(tasks.begin(), tasks.end(), [](const TaskRecord& a, const TaskRecord& b) { return b < a; });
     for (auto& task : tasks) {
-        heap.heapInsert(task);
+        std::cout << task.priority << " " << task.task_name << "\n";
     }
 
-    // move all data from heap to results
-    std::vector<std::unique_ptr<TaskRecord>> results;
-    for (int i = 0; i < tasks.size(); ++i) {
-        results.emplace_back(heap.heapRemoveMax());
+    const std::ptrdiff_t n = argc > 1 ? std::atoll(argv[1]) : 10000000;
+    const std::ptrdiff_t k = argc > 2 ? std::atoll(argv[2]) : 1000;
+
+    std::mt19937 rng{42};
+    std::vector<int> input(n);
+    for (auto& value : input) {
+        value = static_cast<int>(rng());
     }
 
-    for (auto& task : results) {
-        std::cout << task->priority << " " << task->task_name << "\n";
+    struct Result {
+        const char* name;
+        long long ms;
+        bool ok;
+    };
+    std::vector<Result> results;
+    auto run = [&](const char* name, std::ptrdiff_t checked, auto sort) {
+        bool ok = false;
+        long long ms = timeSort(input, sort, ok, checked);
+        results.push_back({name, ms, ok});
+    };
+
+    run("std::sort            ", n, [](std::vector<int>& v) { std::sort(v.begin(), v.end()); });
+    run("std::sort_heap       ", n, [](std::vector<int>& v) {
+        std::make_heap(v.begin(), v.end());
+        std::sort_heap(v.begin(), v.end());
+    });
+    run("heap_sort            ", n, [](std::vector<int>& v) { heap_sort(v.begin(), v.end()); });
+    run("intro_sort           ", n, [](std::vector<int>& v) { intro_sort(v.begin(), v.end()); });
+    run("std::partial_sort (k)", k, [k](std::vector<int>& v) { std::partial_sort(v.begin(), v.begin() + k, v.end()); });
+    run("partial_heap_sort (k)", k, [k](std::vector<int>& v) { partial_heap_sort(v.begin(), v.begin() + k, v.end()); });
+
+    std::cout << "\n" << n << " random ints, k = " << k << "\n";
+    for (auto& result : results) {
+        std::cout << "  " << result.name << ": " << result.ms << " ms" << (result.ok ? "" : " (NOT SORTED)") << "\n";
     }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,247 @@
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+#include "heap.h"
+
+// Min-max heap (Atkinson et al.):
+// Levels alternate between min levels (root level, 2, 4, ...) and max levels (1, 3, ...).
+// Every node on a min level is smaller than everything below it, every node on a max level
+// is larger than everything below it. So the minimum is the root and the maximum is one of
+// the root's two children: both ends can be peeked in O(1) and removed in O(log n), where
+// Heap::heapRemoveMin has to scan all the leaves.
+
+template <class T>
+class MinMaxHeap {
+public:
+    MinMaxHeap() = default;
+    ~MinMaxHeap() = default;
+
+    void heapInsert(const T& value);
+    std::optional<T> heapRemoveMax();
+    std::optional<T> heapRemoveMin();
+
+    const T& min() const { return this->arr[0]; }
+    const T& max() const { return this->arr[maxIndex()]; }
+    int size() const { return static_cast<int>(this->arr.size()); }
+    bool empty() const { return this->arr.empty(); }
+    void reserve(int capacity) { this->arr.reserve(capacity); }
+
+private:
+    std::vector<T> arr;
+
+    static bool isMinLevel(int index);
+    int maxIndex() const;
+    template <bool MinLevel> bool before(int i, int j) const;
+    template <bool MinLevel> void bubbleUpLevel(int index);
+    template <bool MinLevel> void trickleDownLevel(int index);
+    void trickleDown(int index);
+    T take(int index);
+};
+
+template <class T>
+bool MinMaxHeap<T>::isMinLevel(int index) {
+    // level of index is floor(log2(index + 1))
+    int level = 0;
+    for (unsigned int n = static_cast<unsigned int>(index) + 1; n > 1; n >>= 1) {
+        level++;
+    }
+    return level % 2 == 0;
+}
+
+template <class T>
+int MinMaxHeap<T>::maxIndex() const {
+    if (this->arr.size() == 1) {
+        return 0;
+    }
+    if (this->arr.size() == 2 || this->arr[2] < this->arr[1]) {
+        return 1;
+    }
+    return 2;
+}
+
+// on a min level "before" means smaller, on a max level it means larger
+template <class T>
+template <bool MinLevel>
+bool MinMaxHeap<T>::before(int i, int j) const {
+    return MinLevel ? this->arr[i] < this->arr[j] : this->arr[j] < this->arr[i];
+}
+
+// moves index up through its grandparents, which are on the same kind of level
+template <class T>
+template <bool MinLevel>
+void MinMaxHeap<T>::bubbleUpLevel(int index) {
+    while (index > 2) {
+        int grandparent = (index - 3) / 4;
+        if (!before<MinLevel>(index, grandparent)) {
+            break;
+        }
+        std::swap(this->arr[index], this->arr[grandparent]);
+        index = grandparent;
+    }
+}
+
+template <class T>
+void MinMaxHeap<T>::heapInsert(const T& value) {
+    this->arr.push_back(value);
+    int index = static_cast<int>(this->arr.size()) - 1;
+    if (index == 0) {
+        return;
+    }
+
+    // first decide whether the new value belongs to the min or to the max levels
+    int parent = (index - 1) / 2;
+    if (isMinLevel(index)) {
+        if (this->arr[parent] < this->arr[index]) {
+            std::swap(this->arr[parent], this->arr[index]);
+            bubbleUpLevel<false>(parent);
+        } else {
+            bubbleUpLevel<true>(index);
+        }
+    } else {
+        if (this->arr[index] < this->arr[parent]) {
+            std::swap(this->arr[parent], this->arr[index]);
+            bubbleUpLevel<true>(parent);
+        } else {
+            bubbleUpLevel<false>(index);
+        }
+    }
+}
+
+template <class T>
+template <bool MinLevel>
+void MinMaxHeap<T>::trickleDownLevel(int index) {
+    const int count = static_cast<int>(this->arr.size());
+
+    while (true) {
+        int first_child = 2 * index + 1;
+        if (first_child >= count) {
+            return;
+        }
+
+        // best among the (up to) 2 children and 4 grandchildren
+        int best = first_child;
+        if (first_child + 1 < count && before<MinLevel>(first_child + 1, best)) {
+            best = first_child + 1;
+        }
+        int first_grandchild = 4 * index + 3;
+        for (int g = first_grandchild; g < first_grandchild + 4 && g < count; ++g) {
+            if (before<MinLevel>(g, best)) {
+                best = g;
+            }
+        }
+
+        if (!before<MinLevel>(best, index)) {
+            return;
+        }
+        std::swap(this->arr[best], this->arr[index]);
+
+        if (best < first_grandchild) {
+            // a child sits on the opposite kind of level and has no grandchildren to fix
+            return;
+        }
+
+        // the value moved down two levels, it may now be on the wrong side of its parent
+        int parent = (best - 1) / 2;
+        if (before<MinLevel>(parent, best)) {
+            std::swap(this->arr[best], this->arr[parent]);
+        }
+        index = best;
+    }
+}
+
+template <class T>
+void MinMaxHeap<T>::trickleDown(int index) {
+    if (isMinLevel(index)) {
+        trickleDownLevel<true>(index);
+    } else {
+        trickleDownLevel<false>(index);
+    }
+}
+
+template <class T>
+T MinMaxHeap<T>::take(int index) {
+    T removed = std::move(this->arr[index]);
+    if (index != static_cast<int>(this->arr.size()) - 1) {
+        this->arr[index] = std::move(this->arr.back());
+        this->arr.pop_back();
+        trickleDown(index);
+    } else {
+        this->arr.pop_back();
+    }
+    return removed;
+}
+
+template <class T>
+std::optional<T> MinMaxHeap<T>::heapRemoveMin() {
+    if (this->arr.empty()) {
+        return std::nullopt;
+    }
+    return take(0);
+}
+
+template <class T>
+std::optional<T> MinMaxHeap<T>::heapRemoveMax() {
+    if (this->arr.empty()) {
+        return std::nullopt;
+    }
+    return take(maxIndex());
+}
+
+// keeps the `capacity` highest priorities seen so far; returns the time spent in ms
+template <class Buffer>
+long long topN(Buffer& buffer, const std::vector<TaskRecord>& stream, int capacity) {
+    auto start = std::chrono::steady_clock::now();
+    for (auto& task : stream) {
+        buffer.heapInsert(task);
+        if (buffer.size() > capacity) {
+            buffer.heapRemoveMin();
+        }
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    MinMaxHeap<TaskRecord> heap;
+
+    heap.heapInsert(TaskRecord(10, "Task A"));
+    heap.heapInsert(TaskRecord(5, "Task B"));
+    heap.heapInsert(TaskRecord(20, "Task C"));
+    heap.heapInsert(TaskRecord(1, "Task D"));
+    heap.heapInsert(TaskRecord(15, "Task E"));
+
+    std::cout << "Min: " << heap.min().task_name << ", Max: " << heap.max().task_name << "\n";
+
+    while (!heap.empty()) {
+        auto low = heap.heapRemoveMin();
+        std::cout << "Deleted Min: " << low->task_name << " (Priority: " << low->priority << ")\n";
+        auto high = heap.heapRemoveMax();
+        if (high) {
+            std::cout << "Deleted Max: " << high->task_name << " (Priority: " << high->priority << ")\n";
+        }
+    }
+
+    // bounded top-N buffer: insert, then evict the smallest once over capacity
+    const int capacity = argc > 1 ? std::atoi(argv[1]) : 1000;
+    const int stream_length = argc > 2 ? std::atoi(argv[2]) : 1000000;
+
+    std::mt19937 rng{42};
+    std::vector<TaskRecord> stream;
+    stream.reserve(stream_length);
+    for (int i = 0; i < stream_length; ++i) {
+        stream.emplace_back(static_cast<unsigned int>(rng()), "task");
+    }
+
+    MinMaxHeap<TaskRecord> min_max;
+    Heap<TaskRecord> max_heap;
+    long long min_max_ms = topN(min_max, stream, capacity);
+    long long max_heap_ms = topN(max_heap, stream, capacity);
+
+    std::cout << "\nTop " << capacity << " of " << stream_length << " tasks\n";
+    std::cout << "  MinMaxHeap: " << min_max_ms << " ms (max " << min_max.max().priority << ")\n";
+    std::cout << "  Heap:       " << max_heap_ms << " ms (max " << max_heap.top().priority << ")\n";
+
+    return 0;
+}
@@ -0,0 +1,273 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+#include "heap.h"
+
+// Hierarchical timing wheel (Varghese & Lauck), for deadline-driven entries such as
+// connection timeouts where most timers are cancelled before they fire.
+// Four wheels of 256 slots each: wheel 0 has one slot per tick, a slot of wheel 1 covers
+// 256 ticks, a slot of wheel 2 covers 256^2 ticks and so on. An entry goes into the wheel of
+// the highest byte in which its deadline differs from the current tick. Whenever the lower
+// wheel wraps around, the next slot of the wheel above is cascaded down into finer slots.
+// Every slot is an intrusive doubly linked list over one entry array, so timerInsert and
+// erase are O(1), and expiry is amortized O(1) per entry (an entry cascades at most 3 times).
+// Like Heap, timerInsert returns a handle that stays valid until the entry fires or is erased.
+
+template <class T>
+class TimingWheel {
+private:
+    static constexpr int kWheels = 4;
+    static constexpr int kSlotBits = 8;
+    static constexpr int kSlots = 1 << kSlotBits;
+    // one extra list for deadlines beyond 2^32 ticks, revisited when the last wheel wraps
+    static constexpr int kOverflow = kWheels * kSlots;
+
+    struct Entry {
+        uint64_t deadline;
+        T value;
+        int prev;
+        int next;
+        int list;      // index into heads, -1 when the entry is free
+    };
+
+    std::vector<Entry> entries;
+    std::vector<int> heads;
+    std::vector<int> free_handles;
+    uint64_t current_tick;
+    int count;
+
+public:
+    explicit TimingWheel(uint64_t start_tick = 0)
+        : heads(kOverflow + 1, -1), current_tick{start_tick}, count{0} {}
+
+    // deadlines that are already due fire on the next tick
+    int timerInsert(uint64_t deadline, const T& value);
+    bool erase(int handle);
+
+    // moves time forward to `now`, calling on_expire(deadline, value) for every due entry
+    template <class Callback>
+    void advance(uint64_t now, Callback&& on_expire);
+
+    bool contains(int handle) const {
+        return handle >= 0 && handle < static_cast<int>(entries.size()) && entries[handle].list >= 0;
+    }
+    const T& get(int handle) const { return entries[handle].value; }
+    uint64_t now() const { return current_tick; }
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+
+private:
+    int listFor(uint64_t deadline) const;
+    void link(int handle, int list);
+    void unlink(int handle);
+    void cascade(int wheel);
+};
+
+template <class T>
+int TimingWheel<T>::listFor(uint64_t deadline) const {
+    uint64_t differing = deadline ^ current_tick;
+    for (int wheel = 0; wheel < kWheels; ++wheel) {
+        if ((differing >> (kSlotBits * (wheel + 1))) == 0) {
+            return wheel * kSlots + static_cast<int>((deadline >> (kSlotBits * wheel)) & (kSlots - 1));
+        }
+    }
+    return kOverflow;
+}
+
+template <class T>
+void TimingWheel<T>::link(int handle, int list) {
+    Entry& entry = entries[handle];
+    entry.list = list;
+    entry.prev = -1;
+    entry.next = heads[list];
+    if (heads[list] != -1) {
+        entries[heads[list]].prev = handle;
+    }
+    heads[list] = handle;
+}
+
+template <class T>
+void TimingWheel<T>::unlink(int handle) {
+    Entry& entry = entries[handle];
+    if (entry.prev != -1) {
+        entries[entry.prev].next = entry.next;
+    } else {
+        heads[entry.list] = entry.next;
+    }
+    if (entry.next != -1) {
+        entries[entry.next].prev = entry.prev;
+    }
+    entry.list = -1;
+}
+
+template <class T>
+int TimingWheel<T>::timerInsert(uint64_t deadline, const T& value) {
+    if (deadline <= current_tick) {
+        deadline = current_tick + 1;
+    }
+
+    int handle;
+    if (!free_handles.empty()) {
+        handle = free_handles.back();
+        free_handles.pop_back();
+        entries[handle].deadline = deadline;
+        entries[handle].value = value;
+    } else {
+        handle = static_cast<int>(entries.size());
+        entries.push_back({deadline, value, -1, -1, -1});
+    }
+
+    link(handle, listFor(deadline));
+    count++;
+    return handle;
+}
+
+template <class T>
+bool TimingWheel<T>::erase(int handle) {
+    if (!contains(handle)) {
+        return false;
+    }
+    unlink(handle);
+    free_handles.push_back(handle);
+    count--;
+    return true;
+}
+
+// re-files the entries of the current slot of `wheel` into finer slots
+template <class T>
+void TimingWheel<T>::cascade(int wheel) {
+    int list;
+    if (wheel == kWheels) {
+        list = kOverflow;
+    } else {
+        int slot = static_cast<int>((current_tick >> (kSlotBits * wheel)) & (kSlots - 1));
+        // this wheel wrapped as well, bring down the next slot of the wheel above first
+        if (slot == 0) {
+            cascade(wheel + 1);
+        }
+        list = wheel * kSlots + slot;
+    }
+
+    int handle = heads[list];
+    heads[list] = -1;
+    while (handle != -1) {
+        int next = entries[handle].next;
+        link(handle, listFor(entries[handle].deadline));
+        handle = next;
+    }
+}
+
+template <class T>
+template <class Callback>
+void TimingWheel<T>::advance(uint64_t now, Callback&& on_expire) {
+    while (current_tick < now) {
+        if (count == 0) {
+            // nothing can fire, jump straight there
+            current_tick = now;
+            return;
+        }
+
+        current_tick++;
+        int slot = static_cast<int>(current_tick & (kSlots - 1));
+        if (slot == 0) {
+            cascade(1);
+        }
+
+        // pop one entry at a time, the callback may insert or erase other timers
+        while (heads[slot] != -1) {
+            int handle = heads[slot];
+            unlink(handle);
+            uint64_t deadline = entries[handle].deadline;
+            T value = std::move(entries[handle].value);
+            free_handles.push_back(handle);
+            count--;
+            on_expire(deadline, std::move(value));
+        }
+    }
+}
+
+// Heap is a max heap, ordering by reversed deadline puts the earliest deadline on top
+struct HeapTimer {
+    uint64_t deadline;
+    TaskRecord task;
+
+    bool operator < (const HeapTimer& other) const {
+        return other.deadline < deadline;
+    }
+};
+
+int main(int argc, char* argv[]) {
+    TimingWheel<TaskRecord> wheel;
+
+    wheel.timerInsert(30, TaskRecord(1, "idle connection A"));
+    int keep_alive = wheel.timerInsert(100, TaskRecord(1, "idle connection B"));
+    wheel.timerInsert(70000, TaskRecord(2, "handshake C"));
+    wheel.timerInsert(300, TaskRecord(3, "request D"));
+
+    // connection B sent data, its timeout is cancelled
+    wheel.erase(keep_alive);
+
+    auto report = [](uint64_t deadline, TaskRecord task) {
+        std::cout << "Expired at " << deadline << ": " << task.task_name << "\n";
+    };
+    wheel.advance(1000, report);
+    std::cout << "Pending after tick 1000: " << wheel.size() << "\n";
+    wheel.advance(100000, report);
+
+    // connection-timeout workload: most timers are cancelled, the rest expire
+    const int timers = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const int horizon = argc > 2 ? std::atoi(argv[2]) : 60000;
+
+    std::mt19937 rng{42};
+    std::vector<uint64_t> deadlines(timers);
+    std::vector<bool> cancel(timers);
+    for (int i = 0; i < timers; ++i) {
+        deadlines[i] = 1 + rng() % horizon;
+        cancel[i] = rng() % 10 != 0;
+    }
+
+    long long fired = 0;
+    auto start = std::chrono::steady_clock::now();
+    TimingWheel<TaskRecord> timeouts;
+    std::vector<int> handles(timers);
+    for (int i = 0; i < timers; ++i) {
+        handles[i] = timeouts.timerInsert(deadlines[i], TaskRecord(1, "connection"));
+    }
+    for (int i = 0; i < timers; ++i) {
+        if (cancel[i]) {
+            timeouts.erase(handles[i]);
+        }
+    }
+    timeouts.advance(horizon + 1, [&fired](uint64_t, TaskRecord&&) { fired++; });
+    auto wheel_time = std::chrono::steady_clock::now() - start;
+
+    long long heap_fired = 0;
+    start = std::chrono::steady_clock::now();
+    Heap<HeapTimer> heap;
+    for (int i = 0; i < timers; ++i) {
+        handles[i] = heap.heapInsert(HeapTimer{deadlines[i], TaskRecord(1, "connection")});
+    }
+    for (int i = 0; i < timers; ++i) {
+        if (cancel[i]) {
+            heap.erase(handles[i]);
+        }
+    }
+    for (uint64_t tick = 1; tick <= static_cast<uint64_t>(horizon) + 1; ++tick) {
+        while (!heap.empty() && heap.top().deadline <= tick) {
+            heap.heapRemoveMax();
+            heap_fired++;
+        }
+    }
+    auto heap_time = std::chrono::steady_clock::now() - start;
+
+    std::cout << "\n" << timers << " timers, 90% cancelled\n";
+    std::cout << "  TimingWheel: " << std::chrono::duration_cast<std::chrono::milliseconds>(wheel_time).count()
+              << " ms, " << fired << " fired\n";
+    std::cout << "  Heap:        " << std::chrono::duration_cast<std::chrono::milliseconds>(heap_time).count()
+              << " ms, " << heap_fired << " fired\n";
+
+    return 0;
+}
@@ -1,54 +1,96 @@
+#include <algorithm>
+#include <chrono>
 #include <iostream>
-#include <vector>
+#include <memory_resource>
+#include <queue>
+#include <random>
 #include <string>
+#include <utility>
+#include <vector>
+#include "../Memory/pool_resource.h"
 
 class Node {
 public:
     bool is_entry;
-    std::vector<Node*> children;
+    std::pmr::vector<Node*> children;
 
-    Node(): is_entry{false} {
-        children = std::vector<Node*>(27, nullptr);
-    }
-    ~Node() {
-        for (auto child : children) {
-            delete child;
-        }
-    }
+    // score of the entry ending at this node, and the best score found anywhere
+    // in this subtree; max_score is an upper bound used to prune topK searches
+    unsigned int score;
+    unsigned int max_score;
+
+    explicit Node(std::pmr::memory_resource* resource): is_entry{false}, children(27, nullptr, resource), score{0}, max_score{0} {}
 };
 
+// Nodes and their child arrays are allocated from the Trie's memory_resource
+// (the default resource unless one is passed in).
 class Trie {
 private:
     Node* root;
+    std::pmr::memory_resource* resource;
 
 public:
-    Trie() {
-        root = new Node();
+    explicit Trie(std::pmr::memory_resource* resource = std::pmr::get_default_resource()): resource{resource} {
+        root = createNode();
     }
 
     ~Trie() {
-        delete root;
+        destroySubtree(root);
+    }
+
+    Node* createNode() {
+        return new (resource->allocate(sizeof(Node), alignof(Node))) Node(resource);
+    }
+
+    void destroyNode(Node* node) {
+        node->~Node();
+        resource->deallocate(node, sizeof(Node), alignof(Node));
+    }
+
+    // tears the subtree down without recursion: all nodes are collected breadth-first
+    // and then freed deepest-first
+    void destroySubtree(Node* node) {
+        std::vector<Node*> subtree{node};
+        for (std::size_t i = 0; i < subtree.size(); ++i) {
+            for (auto child : subtree[i]->children) {
+                if (child != nullptr) {
+                    subtree.push_back(child);
+                }
+            }
+        }
+
+        for (auto it = subtree.rbegin(); it != subtree.rend(); ++it) {
+            destroyNode(*it);
+        }
     }
 
     void insert(std::string&& new_value) {
-        insertNode(root, std::move(new_value), 0);
+        insertNode(root, std::move(new_value), 0, 0);
     }
 
-    void insertNode(Node* node, std::string&& new_value, int index) {
-        if (index == new_value.length()) {
-            node->is_entry = true;
-            return;
-        } else {
-            char next_letter = new_value[index];
-            int next_index = letterToIndex(next_letter);
+    void insert(std::string&& new_value, unsigned int score) {
+        insertNode(root, std::move(new_value), 0, score);
+    }
+
+    // all Trie walks are loops rather than one stack frame per character,
+    // so keys of any length (e.g. 100KB DNA reads) are safe
+    void insertNode(Node* node, std::string&& new_value, int index, unsigned int score) {
+        const int length = static_cast<int>(new_value.length());
+
+        for (; index < length; ++index) {
+            // every node on the path now has an entry with this score below it
+            node->max_score = std::max(node->max_score, score);
 
+            int next_index = letterToIndex(new_value[index]);
             if (node->children[next_index] == nullptr) {
-                node->children[next_index] = new Node();
-                insertNode(node->children[next_index], std::move(new_value), index + 1);
-            } else {
-                insertNode(node->children[next_index], std::move(new_value), index + 1);
+                node->children[next_index] = createNode();
             }
+            node = node->children[next_index];
         }
+
+        node->max_score = std::max(node->max_score, score);
+        node->is_entry = true;
+        node->score = score;
     }
 
     void search(std::string&& target) {
@@ -60,33 +102,150 @@ public:
         }
     }
 
+    bool contains(std::string&& target) {
+        return searchNode(root, std::move(target), 0) != nullptr;
+    }
+
     int letterToIndex(char next_letter) {
         return std::tolower(next_letter) - 97;
     }
 
-    Node* searchNode(Node* node, std::string&& target, int index) {
-        // in search of correct string, first check the current index with target length
-        // and check whether the node is a valid entry not
-        if (index == target.length()) {
-            if (node->is_entry) {
-                return node;
-            } else {
+    char indexToLetter(int index) {
+        return static_cast<char>(index + 97);
+    }
+
+    // walk down to the node that spells out prefix, nullptr if no entry starts with it
+    Node* prefixNode(const std::string& prefix) {
+        Node* node = root;
+        for (char letter : prefix) {
+            node = node->children[letterToIndex(letter)];
+            if (node == nullptr) {
                 return nullptr;
             }
         }
+        return node;
+    }
 
-        // index start from 0, and it will increase by index + 1
-        char next_letter = target[index];
-        int next_index = letterToIndex(next_letter);
-        Node* next_child = node->children[next_index];
+    // calls visitor(word, score) for every entry starting with prefix, in alphabetical order
+    template <typename Visitor>
+    void forEachWithPrefix(const std::string& prefix, Visitor&& visitor) {
+        Node* node = prefixNode(prefix);
+        if (node == nullptr) {
+            return;
+        }
 
-        if (next_child == nullptr) {
-            return nullptr;
-        } else {
-            return searchNode(next_child, std::move(target), index + 1);
+        std::string word = prefix;
+        std::transform(word.begin(), word.end(), word.begin(), ::tolower);
+        collectEntries(node, word, visitor);
+    }
+
+    // depth-first walk with an explicit stack; each frame remembers the next child to visit
+    template <typename Visitor>
+    void collectEntries(Node* node, std::string& word, Visitor& visitor) {
+        std::vector<std::pair<Node*, int>> stack;
+        if (node->is_entry) {
+            visitor(static_cast<const std::string&>(word), node->score);
+        }
+        stack.emplace_back(node, 0);
+
+        while (!stack.empty()) {
+            auto& [current, next_child] = stack.back();
+            const int child_count = static_cast<int>(current->children.size());
+
+            while (next_child < child_count && current->children[next_child] == nullptr) {
+                next_child++;
+            }
+
+            if (next_child == child_count) {
+                stack.pop_back();
+                if (!stack.empty()) {
+                    word.pop_back();
+                }
+                continue;
+            }
+
+            Node* child = current->children[next_child];
+            word.push_back(indexToLetter(next_child));
+            next_child++;
+
+            if (child->is_entry) {
+                visitor(static_cast<const std::string&>(word), child->score);
+            }
+            stack.emplace_back(child, 0);
         }
     }
 
+    // returns the k highest scored entries starting with prefix, best first.
+    // Subtrees are expanded best-first by their cached max_score, so once k entries
+    // have been popped every remaining subtree is known to score lower and is never visited.
+    std::vector<std::pair<std::string, unsigned int>> topK(const std::string& prefix, int k) {
+        std::vector<std::pair<std::string, unsigned int>> results;
+        Node* start = prefixNode(prefix);
+        if (start == nullptr || k <= 0) {
+            return results;
+        }
+
+        struct Candidate {
+            unsigned int score;
+            bool is_entry;   // true: the word ending at node, false: the whole subtree of node
+            Node* node;
+            std::string word;
+
+            bool operator < (const Candidate& other) const {
+                if (score != other.score) {
+                    return score < other.score;
+                }
+                // on equal scores finish an entry before expanding another subtree
+                return !is_entry && other.is_entry;
+            }
+        };
+
+        std::string word = prefix;
+        std::transform(word.begin(), word.end(), word.begin(), ::tolower);
+
+        std::priority_queue<Candidate> frontier;
+        frontier.push({start->max_score, false, start, std::move(word)});
+
+        while (!frontier.empty() && static_cast<int>(results.size()) < k) {
+            Candidate current = frontier.top();
+            frontier.pop();
+
+            if (current.is_entry) {
+                results.emplace_back(std::move(current.word), current.score);
+                continue;
+            }
+
+            Node* node = current.node;
+            if (node->is_entry) {
+                frontier.push({node->score, true, node, current.word});
+            }
+
+            for (int i = 0; i < static_cast<int>(node->children.size()); ++i) {
+                Node* child = node->children[i];
+                if (child != nullptr) {
+                    frontier.push({child->max_score, false, child, current.word + indexToLetter(i)});
+                }
+            }
+        }
+
+        return results;
+    }
+
+    Node* searchNode(Node* node, std::string&& target, int index) {
+        const int length = static_cast<int>(target.length());
+
+        // follow one child per character, index start from 0 and increase by index + 1
+        for (; index < length; ++index) {
+            node = node->children[letterToIndex(target[index])];
+            if (node == nullptr) {
+                return nullptr;
+            }
+        }
+
+        // the whole target has been consumed, check whether the node is a valid entry or not
+        return node->is_entry ? node : nullptr;
+    }
+
     void remove(std::string&& target) {
         if (deleteNode(this->root, std::move(target), 0)) {
             std::cout << "string completely deleted" << std::endl;
@@ -95,39 +254,71 @@ public:
         }
     }
 
-    bool deleteNode(Node* node, std::string&& target, int index) {
-        if (index == target.length()) {
-            if (node->is_entry) {
-                node->is_entry = false;
-                return true;
+    void refreshMaxScore(Node* node) {
+        node->max_score = node->is_entry ? node->score : 0;
+        for (auto child : node->children) {
+            if (child != nullptr) {
+                node->max_score = std::max(node->max_score, child->max_score);
+            }
+        }
+    }
+
+    bool isLeaf(Node* node) {
+        for (auto child : node->children) {
+            if (child != nullptr) {
+                return false;
             }
         }
+        return true;
+    }
+
+    // returns true when node itself ends up empty and can be deleted by its parent
+    bool deleteNode(Node* node, std::string&& target, int index) {
+        const int length = static_cast<int>(target.length());
 
-        char next_letter = target[index];
-        int next_index = letterToIndex(next_letter);
+        // path[i] is the parent of the node reached after target[index + i]
+        std::vector<Node*> path;
 
-        if (node->children[next_index] != nullptr) {
-            if (deleteNode(node->children[next_index], std::move(target), index + 1)) {
-                delete node->children[next_index];
-                node->children[next_index] = nullptr;
+        Node* current = node;
+        for (int i = index; i < length; ++i) {
+            path.push_back(current);
+            current = current->children[letterToIndex(target[i])];
+            if (current == nullptr) {
+                return false;
             }
-        } else {
-            return false;
         }
 
-        if (node->is_entry) {
+        if (!current->is_entry) {
             return false;
         }
+        current->is_entry = false;
+        refreshMaxScore(current);
 
-        for (auto child : node->children) {
-            if (child != nullptr) {
+        // only drop the node itself when no longer word continues through it
+        bool drop = isLeaf(current);
+
+        // walk back up, deleting emptied nodes and refreshing the cached max scores
+        for (int i = static_cast<int>(path.size()) - 1; i >= 0; --i) {
+            Node* parent = path[i];
+            unsigned int previous_max = parent->max_score;
+
+            if (drop) {
+                int child_index = letterToIndex(target[index + i]);
+                destroyNode(parent->children[child_index]);
+                parent->children[child_index] = nullptr;
+            }
+
+            // the removed entry may have been the best one below this node
+            refreshMaxScore(parent);
+
+            if (!drop && parent->max_score == previous_max) {
+                // nothing changes further up, and parent still holds the rest of the word
                 return false;
             }
+            drop = !parent->is_entry && isLeaf(parent);
         }
 
-        // current node will be a child on next stack of recursion
-        // it will be deleted because this one return true;
-        return true;
+        return drop;
     }
 };
 
@@ -148,6 +339,77 @@ int main(int argc, char* argv[]) {
 
     trie.search("Ramadhan");
 
+    // scored entries for prefix enumeration and autocomplete
+    trie.insert("car", 40);
+    trie.insert("card", 25);
+    trie.insert("care", 70);
+    trie.insert("careful", 55);
+    trie.insert("cart", 90);
+    trie.insert("cat", 10);
+
+    std::cout << "\nEntries starting with \"car\":" << std::endl;
+    trie.forEachWithPrefix("car", [](const std::string& word, unsigned int score) {
+        std::cout << "  " << word << " (" << score << ")" << std::endl;
+    });
+
+    std::cout << "Top 3 completions of \"car\":" << std::endl;
+    for (auto& [word, score] : trie.topK("car", 3)) {
+        std::cout << "  " << word << " (" << score << ")" << std::endl;
+    }
+
+    trie.remove("cart");
+    std::cout << "Top 2 completions of \"ca\" after removing \"cart\":" << std::endl;
+    for (auto& [word, score] : trie.topK("ca", 2)) {
+        std::cout << "  " << word << " (" << score << ")" << std::endl;
+    }
+
+    // long keys: DNA reads of 100KB used to need one stack frame per base
+    const int read_length = argc > 1 ? std::atoi(argv[1]) : 100000;
+    const int read_count = argc > 2 ? std::atoi(argv[2]) : 4;
+
+    std::mt19937 rng{7};
+    std::vector<std::string> reads;
+    for (int r = 0; r < read_count; ++r) {
+        std::string read(read_length, 'a');
+        for (auto& base : read) {
+            base = "acgt"[rng() % 4];
+        }
+        reads.push_back(std::move(read));
+    }
+
+    auto throughput = [&](std::chrono::steady_clock::duration elapsed) {
+        double seconds = std::chrono::duration<double>(elapsed).count();
+        return static_cast<double>(read_length) * read_count / seconds / 1e6;
+    };
+
+    // once with new/delete, once with every node and child array in a PoolResource
+    PoolResource pool;
+    std::pmr::memory_resource* resources[] = {std::pmr::new_delete_resource(), &pool};
+    const char* names[] = {"new/delete", "PoolResource"};
+    for (int run = 0; run < 2; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        Trie* dna = new Trie(resources[run]);
+        for (auto& read : reads) {
+            dna->insert(std::string(read));
+        }
+        auto inserted = std::chrono::steady_clock::now();
+
+        int found = 0;
+        for (auto& read : reads) {
+            found += dna->contains(std::string(read));
+        }
+        auto searched = std::chrono::steady_clock::now();
+
+        delete dna;
+        auto destroyed = std::chrono::steady_clock::now();
+
+        std::cout << "\n" << read_count << " reads of " << read_length << " bases, " << found << " found, "
+                  << names[run] << std::endl;
+        std::cout << "  insert:   " << throughput(inserted - start) << " Mbases/s" << std::endl;
+        std::cout << "  search:   " << throughput(searched - inserted) << " Mbases/s" << std::endl;
+        std::cout << "  teardown: " << throughput(destroyed - searched) << " Mbases/s" << std::endl;
+    }
+
     // this can be compared if we don't use a Trie structure
     // If we use Trie, we don't have to check it like this
     std::vector<std::string> vec;